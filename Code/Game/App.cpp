@@ -13,14 +13,18 @@
 #include "Game/GameCommon.hpp"
 #include "Engine/Core/Timer.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Game/SoftwareRasterizer.hpp"
 #include <iostream>
 #include <winuser.rh>
 
 
 App* g_theApp = nullptr;
 Renderer* g_theRenderer = nullptr;
+RenderBackend* g_theRenderBackend = nullptr;
+SoftwareRasterizer* g_theSoftwareRasterizer = nullptr;
 InputSystem* g_theInput = nullptr;
 AudioSystem* g_theAudio = nullptr;
+AudioThread* g_theAudioThread = nullptr;
 Window* g_theWindow = nullptr;
 BitmapFont* g_theFont = nullptr;
 DevConsole* g_theDevConsole = nullptr;
@@ -54,18 +58,25 @@ void App::Startup()
 
 	g_gameConfigBlackboard.PopulateFromXmlElementAttributes(*gameRoot);
 
+	// softwareRenderer="true" draws every frame on the CPU and never opens a window or a GPU
+	// device, so it runs on machines without either; g_theWindow, g_theRenderer and g_theFont stay null
+	bool isSoftwareRenderer = g_gameConfigBlackboard.GetValue("softwareRenderer", false);
+
 	InputConfig inputConfig;
 	g_theInput = new InputSystem(inputConfig);
 
-	WindowConfig windowConfig;
-	windowConfig.m_aspectRatio = g_gameConfigBlackboard.GetValue("windowAspect", 1.0f);
-	windowConfig.m_inputSystem = g_theInput;
-	windowConfig.m_windowTitle = g_gameConfigBlackboard.GetValue("projectName", Stringf("Unnamed Project"));
-	g_theWindow = new Window(windowConfig);
-
-	RendererConfig rendererConfig;
-	rendererConfig.m_window = g_theWindow;
-	g_theRenderer = new Renderer(rendererConfig);
+	if (!isSoftwareRenderer)
+	{
+		WindowConfig windowConfig;
+		windowConfig.m_aspectRatio = g_gameConfigBlackboard.GetValue("windowAspect", 1.0f);
+		windowConfig.m_inputSystem = g_theInput;
+		windowConfig.m_windowTitle = g_gameConfigBlackboard.GetValue("projectName", Stringf("Unnamed Project"));
+		g_theWindow = new Window(windowConfig);
+
+		RendererConfig rendererConfig;
+		rendererConfig.m_window = g_theWindow;
+		g_theRenderer = new Renderer(rendererConfig);
+	}
 
 	AudioConfig audioConfig;
 	g_theAudio = new AudioSystem(audioConfig);
@@ -78,14 +89,39 @@ void App::Startup()
 	g_theEventSystem = new EventSystem(eventConfig);
 
 	g_theEventSystem->SubscribeEventCallbackFunction("quit", App::Event_Quit);
+	g_theEventSystem->SubscribeEventCallbackFunction("FrameTimes", App::Event_FrameTimes);
+
+	// 0 leaves a mode uncapped; the paused game and the attract screen need far fewer frames
+	m_framePacer.SetTargetFrameRate(FRAME_PACING_GAMEPLAY, g_gameConfigBlackboard.GetValue("gameplayFrameRate", 0.f));
+	m_framePacer.SetTargetFrameRate(FRAME_PACING_PAUSED, g_gameConfigBlackboard.GetValue("pausedFrameRate", 30.f));
+	m_framePacer.SetTargetFrameRate(FRAME_PACING_ATTRACT, g_gameConfigBlackboard.GetValue("attractFrameRate", 30.f));
 
 	g_theInput->Startup();
-	g_theWindow->Startup();
-	g_theRenderer->Startup();
+	if (!isSoftwareRenderer)
+	{
+		g_theWindow->Startup();
+		g_theRenderer->Startup();
+	}
 	g_theAudio->Startup();
+	g_theAudioThread = new AudioThread(g_theAudio);
 	g_theDevConsole->Startup();
-	g_theFont = g_theRenderer->CreateOrGetBitmapFont("Data/Fonts/SquirrelFixedFont");
-	
+
+	if (isSoftwareRenderer)
+	{
+		int frameWidth = g_gameConfigBlackboard.GetValue("softwareWidth", 1600);
+		int frameHeight = g_gameConfigBlackboard.GetValue("softwareHeight", 800);
+		g_theSoftwareRasterizer = new SoftwareRasterizer(frameWidth, frameHeight);
+		g_theRenderBackend = g_theSoftwareRasterizer;
+
+		// headlessFrames=N runs N frames, writes the last one to headlessCaptureFile and quits
+		m_headlessFramesLeft = g_gameConfigBlackboard.GetValue("headlessFrames", 0);
+		m_headlessCaptureFile = g_gameConfigBlackboard.GetValue("headlessCaptureFile", "Frame.tga");
+	}
+	else
+	{
+		g_theFont = g_theRenderer->CreateOrGetBitmapFont("Data/Fonts/SquirrelFixedFont");
+		g_theRenderBackend = new EngineRenderBackend(g_theRenderer);
+	}
 
 	m_game = new Game(g_theApp);
 }
@@ -93,16 +129,31 @@ void App::Startup()
 void App::Update()
 {
 	m_game->Update();
+
+	// the game asks for a reset from inside its own Update; tear it down only once that tick is over
+	if (m_isResetRequested)
+	{
+		m_isResetRequested = false;
+		ResetGame();
+	}
 }
 
 void App::Shutdown()
 {
 	delete m_game;
 	m_game = nullptr;
+	delete g_theRenderBackend;
+	g_theRenderBackend = nullptr;
+	g_theSoftwareRasterizer = nullptr;
+	delete g_theAudioThread;
+	g_theAudioThread = nullptr;
 	g_theAudio->Shutdown();
 	g_theDevConsole->Shutdown();
-	g_theRenderer->Shutdown();
-	g_theWindow->ShutDown();
+	if (g_theRenderer)
+	{
+		g_theRenderer->Shutdown();
+		g_theWindow->ShutDown();
+	}
 	g_theInput->Shutdown();
 	
 	delete g_theEventSystem;
@@ -134,6 +185,42 @@ bool App::Event_Quit(EventArgs& args)
 
 
 
+//-----------------------------------------------------------------------------------------------
+// Prints the frame time histogram since startup or the last reset=true, and the caps.
+//
+bool App::Event_FrameTimes(EventArgs& args)
+{
+	FramePacer& framePacer = g_theApp->m_framePacer;
+	g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("FrameTimes: %d frames, mean %.2f ms, p50 %.1f ms, p99 %.1f ms, max %.2f ms",
+		framePacer.GetNumFrames(), framePacer.GetMeanFrameSeconds() * 1000.0, framePacer.GetFrameSecondsAtPercentile(50.f) * 1000.0,
+		framePacer.GetFrameSecondsAtPercentile(99.f) * 1000.0, framePacer.GetMaxFrameSeconds() * 1000.0));
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  caps: gameplay %.0f, paused %.0f, attract %.0f fps (0 = uncapped); sleep overshoot %.2f ms",
+		framePacer.GetTargetFrameRate(FRAME_PACING_GAMEPLAY), framePacer.GetTargetFrameRate(FRAME_PACING_PAUSED), framePacer.GetTargetFrameRate(FRAME_PACING_ATTRACT),
+		framePacer.GetSleepOvershootSeconds() * 1000.0));
+	VoiceManager const& voiceManager = g_theAudioThread->GetVoiceManager();
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  audio: %d voices (peak %d of %d), %d started, %d coalesced, %d stolen, %d dropped; queue stalls %d",
+		voiceManager.GetNumActiveVoices(), voiceManager.GetPeakVoices(), MAX_SFX_VOICES, voiceManager.GetNumStarted(), voiceManager.GetNumCoalesced(),
+		voiceManager.GetNumStolen(), voiceManager.GetNumDropped(), g_theAudioThread->GetNumProducerStalls()));
+
+	for (int bucketIndex = 0; bucketIndex < FRAME_TIME_HISTOGRAM_BUCKETS; ++bucketIndex)
+	{
+		int count = framePacer.GetHistogramCount(bucketIndex);
+		if (count == 0)
+		{
+			continue;
+		}
+		double bucketMs = static_cast<double>(bucketIndex) * FRAME_TIME_BUCKET_SECONDS * 1000.0;
+		char const* lastBucketSuffix = bucketIndex == FRAME_TIME_HISTOGRAM_BUCKETS - 1 ? "+" : "";
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %5.1f ms%s: %d", bucketMs, lastBucketSuffix, count));
+	}
+
+	if (args.GetValue("reset", false))
+	{
+		framePacer.ResetHistogram();
+	}
+	return true;
+}
+
 bool App::HandleQuitRequested()
 {
 	m_isQuitting = true;
@@ -145,9 +232,11 @@ void App::BeginFrame()
 	Clock::TickSystemClock();
 
 	g_theInput->BeginFrame();
-	g_theWindow->BeginFrame();
-	g_theRenderer->BeginFrame();
-	g_theAudio->BeginFrame();
+	if (g_theRenderer)
+	{
+		g_theWindow->BeginFrame();
+		g_theRenderer->BeginFrame();
+	}
 	
 	g_theDevConsole->BeginFrame();
 	g_theEventSystem->BeginFrame();
@@ -160,10 +249,15 @@ void App::ResetGame()
 {
 	m_game->Shutdown();
 	m_game->m_isAttractMode = true;
-	m_game->~Game();
+	delete m_game;
 	m_game = new Game(g_theApp);
 }
 
+void App::RequestResetGame()
+{
+	m_isResetRequested = true;
+}
+
 // Some simple OpenGL example drawing code.
 // This is the graphical equivalent of printing "Hello, world."
 void App::Render() const
@@ -173,9 +267,13 @@ void App::Render() const
 
 void App::EndFrame()
 {
-	g_theAudio->EndFrame();
-	g_theRenderer->EndFrame();
-	g_theWindow->EndFrame();
+	g_theAudioThread->EndFrame();
+	g_theRenderBackend->EndFrame();
+	if (g_theRenderer)
+	{
+		g_theRenderer->EndFrame();
+		g_theWindow->EndFrame();
+	}
 	g_theInput->EndFrame();
 	g_theDevConsole->EndFrame();
 	g_theEventSystem->EndFrame();
@@ -187,4 +285,18 @@ void App::RunFrame()
 	Update();
 	Render();
 	EndFrame();
+	m_framePacer.EndFrame(m_game->GetFramePacingMode());
+	m_game->m_qualityGovernor.AddFrame(m_framePacer.GetLastWorkSeconds(), m_framePacer.GetLastFrameSeconds());
+
+	if (m_headlessFramesLeft > 0)
+	{
+		--m_headlessFramesLeft;
+		if (m_headlessFramesLeft == 0)
+		{
+			EventArgs args;
+			args.SetValue("file", m_headlessCaptureFile);
+			FireEvent("SaveFrame", args);
+			HandleQuitRequested();
+		}
+	}
 }
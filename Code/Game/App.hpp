@@ -4,6 +4,7 @@
 #include <Engine/Core/Vertex_PCU.hpp>
 #include "Engine/Core/EventSystem.hpp"
 #include "Game/Game.hpp"
+#include "Game/FramePacer.hpp"
 
 class App 
 {
@@ -18,7 +19,9 @@ public:
 	bool IsQuitting() const { return m_isQuitting; }
 	
 	void ResetGame();
+	void RequestResetGame();
 	static bool Event_Quit(EventArgs& args);
+	static bool Event_FrameTimes(EventArgs& args);
 
 	Game* m_game = nullptr;
 private:
@@ -32,5 +35,9 @@ private:
 private:
 	
 	bool m_isQuitting			= false;
+	bool m_isResetRequested		= false;
+	FramePacer m_framePacer;
+	int m_headlessFramesLeft	= 0;
+	std::string m_headlessCaptureFile;
 
 };
\ No newline at end of file
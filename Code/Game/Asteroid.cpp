@@ -1,16 +1,17 @@
 ﻿#include "Game/Asteroid.hpp"
+#include "Game/DebugDrawBatch.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/MeshLibrary.hpp"
 #include "Game/App.hpp"
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Core/Clock.hpp"
 #include <math.h>
 
 extern App* g_theApp;
 extern Renderer* g_theRenderer;
-extern AudioSystem* g_theAudio;
 RandomNumberGenerator rng;
 
 Asteroid::Asteroid(Game* owner, const Vec2& startPos, float orientationDeg, Rgba8 color)
@@ -21,8 +22,8 @@ Asteroid::Asteroid(Game* owner, const Vec2& startPos, float orientationDeg, Rgba
 	m_physicsRadius = ASTEROID_PHYSICS_RADIUS;
 	m_cosmeticRadius = ASTEROID_COSMETIC_RADIUS;
 	m_health = 4;
+	m_meshId = static_cast<unsigned short>(MESH_ASTEROID_FIRST + rng.RollRandomIntInRange(0, NUM_ASTEROID_MESH_VARIANTS - 1));
 	
-	InitializeLocalVerts();
 }
 
 Asteroid::~Asteroid()
@@ -76,70 +77,58 @@ void Asteroid::HandleOffscreen()
 		else if (m_position.y > WORLD_SIZE_Y) {
 			m_position.y = 0.f;
 		}
+
+		// wrapping is a teleport, not motion; keep swept tests from sweeping across the world
+		m_lastPosition = m_position;
 	}
 }
 
 
-void Asteroid::RenderAsteroid() const
+void Asteroid::ExtractRenderProxies(RenderSnapshot& snapshot) const
 {
-	Vertex_PCU tempWorldVerts[NUM_ASTEROID_VERTS];
-	for (int vertIndex = 0; vertIndex < NUM_ASTEROID_VERTS; ++vertIndex)
+	snapshot.AddProxy(m_meshId, LAYER_ASTEROIDS, m_position, m_rotateDegree, m_color);
+	if (snapshot.m_showHealthBars)
 	{
-		tempWorldVerts[vertIndex] = m_localVerts[vertIndex];
-		tempWorldVerts[vertIndex].m_color = m_color;
+		snapshot.AddLine(LAYER_ASTEROIDS, Vec2(m_position.x - 2.f, m_position.y + 3.5f), Vec2(m_position.x + 2.f, m_position.y + 3.5f), 0.5f, Rgba8(255, 0, 0, 255));
+		snapshot.AddLine(LAYER_ASTEROIDS, Vec2(m_position.x - 2.f, m_position.y + 3.5f), Vec2(m_position.x - 2.f + (m_health * 1.f), m_position.y + 3.5f), 0.5f, Rgba8(0, 255, 0, 255));
 	}
-
-	TransformVertexArrayXY3D(NUM_ASTEROID_VERTS, &tempWorldVerts[0], 1.f, m_rotateDegree, m_position);
-	g_theRenderer->DrawVertexArray(NUM_ASTEROID_VERTS, &tempWorldVerts[0]);
-}
-void Asteroid::RenderHealthBar() const
-{
-	DebugDrawLine(Vec2(m_position.x - 2.f, m_position.y + 3.5f), Vec2(m_position.x + 2.f, m_position.y + 3.5f), 0.5f, Rgba8(255, 0, 0, 255));
-	DebugDrawLine(Vec2(m_position.x - 2.f, m_position.y + 3.5f), Vec2(m_position.x - 2.f + (m_health * 1.f), m_position.y + 3.5f), 0.5f, Rgba8(0, 255, 0, 255));
 }
-void Asteroid::Render() const
-{
-	RenderAsteroid();
-	RenderHealthBar();
-}
-
 
-
-void Asteroid::DebugRender() const
+void Asteroid::ExtractDebugShapes(DebugShapeList& debugShapes) const
 {
-	DebugDrawRing(m_position, m_physicsRadius, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 255, 255));
-	DebugDrawRing(m_position, m_cosmeticRadius, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 255, 255));
+	debugShapes.AddRing(m_position, m_physicsRadius, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 255, 255));
+	debugShapes.AddRing(m_position, m_cosmeticRadius, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 255, 255));
 
 	Vec2 fwdCartPos = Vec2::MakeFromPolarDegrees(m_rotateDegree, m_cosmeticRadius);
 	Vec2 fwdPos = Vec2(m_position.x + fwdCartPos.x, m_position.y + fwdCartPos.y);
-	DebugDrawLine(m_position, fwdPos, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 0, 255));
+	debugShapes.AddLine(m_position, fwdPos, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 0, 255));
 
 	Vec2 velCartPos = Vec2::MakeFromPolarDegrees(Atan2Degrees(m_velocity.y, m_velocity.x), m_velocity.GetLength());
 	Vec2 velPos = Vec2(m_position.x + velCartPos.x, m_position.y + velCartPos.y);
-	DebugDrawLine(m_position, velPos, DEBUG_LINE_THICKNESS, Rgba8(255, 255, 0, 255));
+	debugShapes.AddLine(m_position, velPos, DEBUG_LINE_THICKNESS, Rgba8(255, 255, 0, 255));
 
 }
 
 void Asteroid::Die()
 {
 	m_isDead = true;
-	m_isGarbage = true;
-	m_game->AddCameraShakeTrauma(0.1f, true);
-	m_game->AddCameraShakeTrauma(0.1f, false);
-	SoundID die = g_theAudio->CreateOrGetSound("Data/Audio/Die.wav");
-	g_theAudio->StartSound(die, false, 0.1f);
-	m_game->SpawnNewDebrisCluster(8, m_position, m_velocity, 5.f, m_physicsRadius * DEBRIS_SCALE, m_originalColor);
+	GameCommandBuffer& commands = m_game->GetCommandBuffer();
+	commands.Despawn(this);
+	commands.AddCameraShake(0.1f, ALL_PLAYERS);
+	commands.PlaySound(SOUND_DIE, 0.1f);
+	commands.SpawnDebrisCluster(8, m_position, m_velocity, 5.f, m_physicsRadius * DEBRIS_SCALE, m_originalColor);
 }
 
-void Asteroid::InitializeLocalVerts()
+//-----------------------------------------------------------------------------------------------
+// Vertex 0 is the center and vertex i + 1 the i-th rim point; each fan triangle indexes two
+// neighbouring rim points and the center.
+//
+void Asteroid::InitializeVerts(Vertex_PCU* vertsToFillIn, unsigned int* indexesToFillIn, RandomNumberGenerator& rng)
 {
-
-	RandomNumberGenerator m_rng;
-
 	float asteroidLens[NUM_ASTEROID_TRIS] = {};
 	for (int asSideIndex = 0; asSideIndex < NUM_ASTEROID_TRIS; ++asSideIndex)
 	{
-		float randomLen = m_rng.RollRandomFloatInRange(m_physicsRadius, m_cosmeticRadius);
+		float randomLen = rng.RollRandomFloatInRange(ASTEROID_PHYSICS_RADIUS, ASTEROID_COSMETIC_RADIUS);
 		asteroidLens[asSideIndex] = randomLen;
 	}
 
@@ -151,25 +140,21 @@ void Asteroid::InitializeLocalVerts()
 		asteroidDegs[asDegIndex] = degrees;
 	}
 	
+	vertsToFillIn[0].m_position = Vec3(0.f, 0.f, 0.f);
+	vertsToFillIn[0].m_color = Rgba8(255, 255, 255, 255);
+
 	for (int asPosIndex = 0; asPosIndex < NUM_ASTEROID_TRIS; ++asPosIndex)
 	{
-		int firstVertIndex = asPosIndex;
-		int lastVertIndex = (asPosIndex + 1) % NUM_ASTEROID_TRIS;
-
-		Vec3 firstPos = GetAsteroidVertex(asteroidLens[firstVertIndex], asteroidDegs[firstVertIndex]);
-		Vec3 lastPos = GetAsteroidVertex(asteroidLens[lastVertIndex], asteroidDegs[lastVertIndex]);
+		vertsToFillIn[asPosIndex + 1].m_position = GetAsteroidVertex(asteroidLens[asPosIndex], asteroidDegs[asPosIndex]);
+		vertsToFillIn[asPosIndex + 1].m_color = Rgba8(255, 255, 255, 255);
 
 		int first = asPosIndex * 3;
 		int second = asPosIndex * 3 + 1;
 		int third = asPosIndex * 3 + 2;
-		
-		m_localVerts[first].m_position = firstPos;
-		m_localVerts[third].m_position = Vec3(0.f, 0.f, 0.f);
-		m_localVerts[second].m_position = lastPos;
-
-		m_localVerts[first].m_color = m_color;
-		m_localVerts[third].m_color = m_color;
-		m_localVerts[second].m_color = m_color;
+
+		indexesToFillIn[first] = asPosIndex + 1;
+		indexesToFillIn[second] = (asPosIndex + 1) % NUM_ASTEROID_TRIS + 1;
+		indexesToFillIn[third] = 0;
 	}
 
 }
@@ -4,11 +4,11 @@
 #include "Engine/Core/Vertex_PCU.hpp"
 
 class Game;
+class RandomNumberGenerator;
 
 constexpr int NUM_ASTEROID_TRIS = 16;
-constexpr int NUM_ASTEROID_VERTS = 3 * NUM_ASTEROID_TRIS;
-constexpr int NUM_ASTEROID_HEALTH_TRIS = 6;
-constexpr int NUM_ASTEROID_HEALTH_VERTS = 3 * NUM_ASTEROID_HEALTH_TRIS;
+constexpr int NUM_ASTEROID_VERTS = NUM_ASTEROID_TRIS + 1;
+constexpr int NUM_ASTEROID_INDEXES = 3 * NUM_ASTEROID_TRIS;
 
 class Asteroid : public Entity
 {
@@ -17,24 +17,20 @@ public:
 	~Asteroid();
 
 	virtual void Update(float deltaSeconds) override;
-	virtual void Render() const override;
-	virtual void DebugRender() const override;
+	virtual void ExtractRenderProxies(RenderSnapshot& snapshot) const override;
+	virtual void ExtractDebugShapes(DebugShapeList& debugShapes) const override;
 	virtual void Die() override;
 
+	static void InitializeVerts(Vertex_PCU* vertsToFillIn, unsigned int* indexesToFillIn, RandomNumberGenerator& rng);
+
 	void HandleBeHitted(float deltaSeconds);
 	void HandleOffscreen();
 
-	void RenderAsteroid() const;
-	void RenderHealthBar() const;
 
 private:
-	void InitializeLocalVerts();
-
-	Vec3 GetAsteroidVertex(float lens, float degrees);
+	static Vec3 GetAsteroidVertex(float lens, float degrees);
 
 private:
-	Vertex_PCU m_localVerts[NUM_ASTEROID_VERTS];
-	Vertex_PCU m_localHealthBar[NUM_ASTEROID_HEALTH_VERTS];
 	float m_rotateDegree;
 	
 
@@ -0,0 +1,179 @@
+#include "Game/AudioThread.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+
+static_assert((AUDIO_QUEUE_CAPACITY & (AUDIO_QUEUE_CAPACITY - 1)) == 0, "AUDIO_QUEUE_CAPACITY must be a power of two");
+
+AudioThread::AudioThread(AudioSystem* audioSystem)
+	: m_audioSystem(audioSystem)
+	, m_writeIndex(0)
+	, m_readIndex(0)
+{
+#if defined(_DEBUG)
+	m_producerThreadId = std::this_thread::get_id();
+#endif
+	m_thread = std::thread(&AudioThread::ThreadMain, this);
+}
+
+//-----------------------------------------------------------------------------------------------
+// Everything queued before this still runs, so final stops reach FMOD before it shuts down.
+//
+AudioThread::~AudioThread()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_isShuttingDown = true;
+	}
+	m_wakeCondition.notify_one();
+	m_thread.join();
+}
+
+void AudioThread::PlaySound(SoundId sound, float volume)
+{
+	AudioCommand command;
+	command.m_type = AudioCommandType::PLAY_SOUND;
+	command.m_sound = sound;
+	command.m_volume = volume;
+	Push(command);
+}
+
+AudioHandle AudioThread::PlayControlledSound(SoundId sound, float volume, bool isLooped)
+{
+	AudioCommand command;
+	command.m_type = AudioCommandType::PLAY_SOUND;
+	command.m_sound = sound;
+	command.m_volume = volume;
+	command.m_isLooped = isLooped;
+	command.m_handle = m_nextHandle;
+	m_nextHandle = (m_nextHandle + 1) % MAX_AUDIO_HANDLES;
+	Push(command);
+	return command.m_handle;
+}
+
+void AudioThread::StopSound(AudioHandle handle)
+{
+	if (handle == INVALID_AUDIO_HANDLE)
+	{
+		return;
+	}
+
+	AudioCommand command;
+	command.m_type = AudioCommandType::STOP_SOUND;
+	command.m_handle = handle;
+	Push(command);
+}
+
+void AudioThread::SetSoundVolume(AudioHandle handle, float volume)
+{
+	if (handle == INVALID_AUDIO_HANDLE)
+	{
+		return;
+	}
+
+	AudioCommand command;
+	command.m_type = AudioCommandType::SET_VOLUME;
+	command.m_handle = handle;
+	command.m_volume = volume;
+	Push(command);
+}
+
+void AudioThread::EndFrame()
+{
+	AudioCommand command;
+	command.m_type = AudioCommandType::UPDATE;
+	Push(command);
+	Wake();
+}
+
+//-----------------------------------------------------------------------------------------------
+// A full ring wakes the audio thread and waits for it to make room; with a frame's worth of
+// sounds far below the capacity, that only happens if the audio thread falls far behind.
+//
+void AudioThread::Push(AudioCommand const& command)
+{
+#if defined(_DEBUG)
+	ASSERT_OR_DIE(std::this_thread::get_id() == m_producerThreadId, "AudioThread commands must come from the thread that created it");
+#endif
+
+	unsigned int writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+	if (writeIndex - m_readIndex.load(std::memory_order_acquire) >= AUDIO_QUEUE_CAPACITY)
+	{
+		++m_numProducerStalls;
+		Wake();
+		while (writeIndex - m_readIndex.load(std::memory_order_acquire) >= AUDIO_QUEUE_CAPACITY)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	m_queue[writeIndex & (AUDIO_QUEUE_CAPACITY - 1)] = command;
+	m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+void AudioThread::Wake()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_wakeIndex += 1;
+	}
+	m_wakeCondition.notify_one();
+}
+
+void AudioThread::ThreadMain()
+{
+	// commands pushed while this loads just wait in the ring
+	m_soundBank.Load(*m_audioSystem);
+
+	unsigned int lastWakeIndex = 0;
+	for (;;)
+	{
+		bool isShuttingDown = false;
+		{
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			m_wakeCondition.wait(lock, [this, lastWakeIndex]() { return m_wakeIndex != lastWakeIndex || m_isShuttingDown; });
+			lastWakeIndex = m_wakeIndex;
+			isShuttingDown = m_isShuttingDown;
+		}
+
+		m_batchSeconds = GetCurrentTimeSeconds();
+		unsigned int readIndex = m_readIndex.load(std::memory_order_relaxed);
+		unsigned int writeIndex = m_writeIndex.load(std::memory_order_acquire);
+		for (; readIndex != writeIndex; ++readIndex)
+		{
+			Execute(m_queue[readIndex & (AUDIO_QUEUE_CAPACITY - 1)]);
+			m_readIndex.store(readIndex + 1, std::memory_order_release);
+		}
+
+		if (isShuttingDown)
+		{
+			return;
+		}
+	}
+}
+
+void AudioThread::Execute(AudioCommand const& command)
+{
+	switch (command.m_type)
+	{
+	case AudioCommandType::PLAY_SOUND:
+		if (command.m_handle == INVALID_AUDIO_HANDLE)
+		{
+			m_voiceManager.PlaySound(*m_audioSystem, m_soundBank, command.m_sound, command.m_volume, m_batchSeconds);
+		}
+		else
+		{
+			m_playbacks[command.m_handle] = m_audioSystem->StartSound(m_soundBank.GetSound(command.m_sound), command.m_isLooped, command.m_volume);
+		}
+		break;
+	case AudioCommandType::STOP_SOUND:
+		m_audioSystem->StopSound(m_playbacks[command.m_handle]);
+		break;
+	case AudioCommandType::SET_VOLUME:
+		m_audioSystem->SetSoundPlaybackVolume(m_playbacks[command.m_handle], command.m_volume);
+		break;
+	case AudioCommandType::UPDATE:
+		m_audioSystem->BeginFrame();
+		m_audioSystem->EndFrame();
+		break;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "Game/VoiceManager.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+constexpr int AUDIO_QUEUE_CAPACITY = 1024;		// must be a power of two
+constexpr int MAX_AUDIO_HANDLES = 64;			// controllable playbacks; handles are reused round robin
+
+typedef int AudioHandle;
+constexpr AudioHandle INVALID_AUDIO_HANDLE = -1;
+
+enum class AudioCommandType : unsigned char
+{
+	PLAY_SOUND,
+	STOP_SOUND,
+	SET_VOLUME,
+	UPDATE,
+};
+
+struct AudioCommand
+{
+	AudioCommandType	m_type = AudioCommandType::PLAY_SOUND;
+	SoundId				m_sound = SOUND_BACK;
+	bool				m_isLooped = false;
+	float				m_volume = 0.f;
+	AudioHandle			m_handle = INVALID_AUDIO_HANDLE;
+};
+
+//-----------------------------------------------------------------------------------------------
+// Owns every AudioSystem call between startup and shutdown, starting with loading the SoundBank.
+// The game pushes small commands into a fixed single-producer, single-consumer ring; pushing is
+// two atomic operations and never locks. EndFrame queues the per-frame FMOD update and wakes the
+// thread, which then plays everything queued so far. So sounds start at most one frame after
+// they are requested, as they did when ApplyCommandBuffers called FMOD directly.
+//
+// The single producer is the thread that constructed this (the main thread). Sim tasks never
+// call in: their sounds go through the GameCommandBuffers, which Game::Update applies on the
+// main thread after the TaskGraph finishes. Debug builds die on a push from any other thread.
+//
+// One-shot sounds go through the VoiceManager, which merges repeats and caps the voice count.
+// Sounds the game needs to stop or change later (music) are started with PlayControlledSound.
+// It returns a handle right away; the audio thread maps it to the FMOD playback once it exists.
+//
+class AudioThread
+{
+public:
+	explicit AudioThread(AudioSystem* audioSystem);
+	~AudioThread();
+
+	void PlaySound(SoundId sound, float volume);
+	AudioHandle PlayControlledSound(SoundId sound, float volume, bool isLooped);
+	void StopSound(AudioHandle handle);
+	void SetSoundVolume(AudioHandle handle, float volume);
+	void EndFrame();
+
+	int GetNumProducerStalls() const { return m_numProducerStalls; }	// pushes that found the ring full
+	VoiceManager const& GetVoiceManager() const { return m_voiceManager; }
+
+private:
+	void Push(AudioCommand const& command);
+	void Wake();
+	void ThreadMain();
+	void Execute(AudioCommand const& command);
+
+private:
+	AudioSystem*				m_audioSystem = nullptr;
+	SoundBank					m_soundBank;						// audio thread side
+	VoiceManager				m_voiceManager;						// audio thread side
+	double						m_batchSeconds = 0.0;				// audio thread side; when the current drain began
+	AudioCommand				m_queue[AUDIO_QUEUE_CAPACITY];
+	alignas(64) std::atomic<unsigned int>	m_writeIndex;		// advanced by the producer only
+	alignas(64) std::atomic<unsigned int>	m_readIndex;		// advanced by the audio thread only
+
+	std::thread					m_thread;
+	std::mutex					m_wakeMutex;
+	std::condition_variable		m_wakeCondition;
+	unsigned int				m_wakeIndex = 0;
+	bool						m_isShuttingDown = false;
+
+	AudioHandle					m_nextHandle = 0;					// producer side
+	int							m_numProducerStalls = 0;			// producer side
+#if defined(_DEBUG)
+	std::thread::id				m_producerThreadId;					// the only thread allowed to push
+#endif
+	SoundPlaybackID				m_playbacks[MAX_AUDIO_HANDLES] = {};	// audio thread side
+};
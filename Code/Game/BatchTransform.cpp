@@ -0,0 +1,112 @@
+#include "Game/BatchTransform.hpp"
+#include "Game/RenderCommandList.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define BATCH_TRANSFORM_SSE2
+#include <emmintrin.h>
+#endif
+
+//-----------------------------------------------------------------------------------------------
+// Same rounding as ExpandInstance. Skipped for opaque white tints, the common case.
+//
+static void TintVerts(Rgba8 const& tint, Vertex_PCU const* meshVerts, int numVerts, Vertex_PCU* out_verts)
+{
+	if (tint.r == 255 && tint.g == 255 && tint.b == 255 && tint.a == 255)
+	{
+		return;
+	}
+
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		Rgba8 const& meshColor = meshVerts[vertIndex].m_color;
+		Rgba8& color = out_verts[vertIndex].m_color;
+		color.r = static_cast<unsigned char>((meshColor.r * tint.r + 127) / 255);
+		color.g = static_cast<unsigned char>((meshColor.g * tint.g + 127) / 255);
+		color.b = static_cast<unsigned char>((meshColor.b * tint.b + 127) / 255);
+		color.a = static_cast<unsigned char>((meshColor.a * tint.a + 127) / 255);
+	}
+}
+
+#if defined(BATCH_TRANSFORM_SSE2)
+//-----------------------------------------------------------------------------------------------
+// One instance, NUM_GROUPS groups of four vertices. NUM_GROUPS of 0 means the count is only
+// known at run time; the fixed counts let the compiler fully unroll the common mesh sizes.
+//
+template <int NUM_GROUPS>
+static void TransformInstance(float const* localXs, float const* localYs, Vertex_PCU const* meshVerts, int numMeshVerts,
+							  int numGroups, RenderInstance const& instance, Vertex_PCU* out_verts)
+{
+	if (NUM_GROUPS > 0)
+	{
+		numGroups = NUM_GROUPS;
+	}
+
+	__m128 cosine = _mm_set1_ps(instance.m_rotation.x);
+	__m128 sine = _mm_set1_ps(instance.m_rotation.y);
+	__m128 scaleX = _mm_set1_ps(instance.m_scale.x);
+	__m128 scaleY = _mm_set1_ps(instance.m_scale.y);
+	__m128 positionX = _mm_set1_ps(instance.m_position.x);
+	__m128 positionY = _mm_set1_ps(instance.m_position.y);
+
+	for (int groupIndex = 0; groupIndex < numGroups; ++groupIndex)
+	{
+		int firstVert = groupIndex * BATCH_TRANSFORM_LANES;
+		__m128 localX = _mm_mul_ps(_mm_loadu_ps(localXs + firstVert), scaleX);
+		__m128 localY = _mm_mul_ps(_mm_loadu_ps(localYs + firstVert), scaleY);
+		__m128 worldX = _mm_add_ps(positionX, _mm_sub_ps(_mm_mul_ps(cosine, localX), _mm_mul_ps(sine, localY)));
+		__m128 worldY = _mm_add_ps(positionY, _mm_add_ps(_mm_mul_ps(sine, localX), _mm_mul_ps(cosine, localY)));
+
+		alignas(16) float worldXs[BATCH_TRANSFORM_LANES];
+		alignas(16) float worldYs[BATCH_TRANSFORM_LANES];
+		_mm_store_ps(worldXs, worldX);
+		_mm_store_ps(worldYs, worldY);
+
+		int numLanes = numMeshVerts - firstVert < BATCH_TRANSFORM_LANES ? numMeshVerts - firstVert : BATCH_TRANSFORM_LANES;
+		for (int lane = 0; lane < numLanes; ++lane)
+		{
+			Vertex_PCU& vert = out_verts[firstVert + lane];
+			vert = meshVerts[firstVert + lane];
+			vert.m_position.x = worldXs[lane];
+			vert.m_position.y = worldYs[lane];
+		}
+	}
+
+	TintVerts(instance.m_tint, meshVerts, numMeshVerts, out_verts);
+}
+
+template <int NUM_GROUPS>
+static void TransformInstanceRange(float const* localXs, float const* localYs, Vertex_PCU const* meshVerts, int numMeshVerts,
+								   RenderInstance const* instances, int numInstances, Vertex_PCU* out_verts)
+{
+	int numGroups = GetNumBatchTransformGroups(numMeshVerts);
+	for (int instanceIndex = 0; instanceIndex < numInstances; ++instanceIndex)
+	{
+		TransformInstance<NUM_GROUPS>(localXs, localYs, meshVerts, numMeshVerts, numGroups, instances[instanceIndex], out_verts);
+		out_verts += numMeshVerts;
+	}
+}
+#endif
+
+void TransformInstances(float const* localXs, float const* localYs, Vertex_PCU const* meshVerts, int numMeshVerts,
+						RenderInstance const* instances, int numInstances, Vertex_PCU* out_verts)
+{
+#if defined(BATCH_TRANSFORM_SSE2)
+	switch (GetNumBatchTransformGroups(numMeshVerts))
+	{
+	case 1: TransformInstanceRange<1>(localXs, localYs, meshVerts, numMeshVerts, instances, numInstances, out_verts); break;
+	case 2: TransformInstanceRange<2>(localXs, localYs, meshVerts, numMeshVerts, instances, numInstances, out_verts); break;
+	case 3: TransformInstanceRange<3>(localXs, localYs, meshVerts, numMeshVerts, instances, numInstances, out_verts); break;
+	case 5: TransformInstanceRange<5>(localXs, localYs, meshVerts, numMeshVerts, instances, numInstances, out_verts); break;
+	default: TransformInstanceRange<0>(localXs, localYs, meshVerts, numMeshVerts, instances, numInstances, out_verts); break;
+	}
+#else
+	UNUSED(localXs);
+	UNUSED(localYs);
+	for (int instanceIndex = 0; instanceIndex < numInstances; ++instanceIndex)
+	{
+		ExpandInstance(meshVerts, numMeshVerts, instances[instanceIndex], out_verts);
+		out_verts += numMeshVerts;
+	}
+#endif
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+
+struct RenderInstance;
+
+constexpr int BATCH_TRANSFORM_LANES = 4;
+
+//-----------------------------------------------------------------------------------------------
+// Batched form of ExpandInstance: writes numInstances copies of one mesh, each transformed by
+// its instance, into out_verts back to back. localXs/localYs are the mesh positions split into
+// separate arrays and padded with zeros to a multiple of BATCH_TRANSFORM_LANES; meshVerts
+// supplies colors and UVs. Positions are transformed four vertices at a time with SSE2. The
+// result must match ExpandInstance bit for bit; Code/Tests checks that for every group count.
+//
+void TransformInstances(float const* localXs, float const* localYs, Vertex_PCU const* meshVerts, int numMeshVerts,
+						RenderInstance const* instances, int numInstances, Vertex_PCU* out_verts);
+
+inline int GetNumBatchTransformGroups(int numVerts) { return (numVerts + BATCH_TRANSFORM_LANES - 1) / BATCH_TRANSFORM_LANES; }
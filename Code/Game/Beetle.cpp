@@ -1,14 +1,15 @@
 ﻿#include "Beetle.hpp"
+#include "Game/DebugDrawBatch.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/MeshLibrary.hpp"
 #include "Game/Game.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Game/PlayerShip.hpp"
 #include <Engine/Core/VertexUtils.hpp>
-#include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Game/App.hpp"
 
 extern App* g_theApp;
-extern AudioSystem* g_theAudio;
 
 Bettle::Bettle(Game* owner, Vec2 startPos, float orientationDeg, Rgba8 color)
 	:Entity(owner, startPos, orientationDeg, color)
@@ -16,7 +17,7 @@ Bettle::Bettle(Game* owner, Vec2 startPos, float orientationDeg, Rgba8 color)
 	m_physicsRadius = BEETLE_PHYSICS_RADIUS;
 	m_cosmeticRadius = BEETLE_COSMETIC_RADIUS;
 	m_health = 4;
-	InitializeLocalVerts();
+	m_meshId = MESH_BEETLE;
 	
 }
 
@@ -35,112 +36,54 @@ void Bettle::Update(float deltaSeconds)
 
 void Bettle::UpdateOrientationDeg()
 {
-	if (!m_game->m_multiplayer)
+	PlayerShip* target = m_game->FindNearestTargetableShip(m_position);
+	if (target)
 	{
-		Vec2 fwdDegrees = m_game->GetPlayership(0)->GetPosition() - m_position;
-		if (m_game->GetPlayership(0)->IsAlive() && !m_game->GetPlayership(0)->m_isInvisible)
-		{
-			m_orientationDegrees = Atan2Degrees(fwdDegrees.y, fwdDegrees.x);
-			m_velocity = Vec2(BEETLE_SPEED * CosDegrees(m_orientationDegrees), BEETLE_SPEED * SinDegrees(m_orientationDegrees));
-		}
-	}
-
-	else
-	{
-		PlayerShip* playerA = m_game->GetPlayership(0);
-		PlayerShip* playerB = m_game->GetPlayership(1);
-
-		bool playerAIsValid = playerA != nullptr && playerA->IsAlive() && !playerA->m_isInvisible;
-		bool playerBIsValid = playerB != nullptr && playerB->IsAlive() && !playerB->m_isInvisible;
-
-		if (playerAIsValid && playerBIsValid)
-		{
-			float distToPlayer0 = (playerA->GetPosition() - m_position).GetLengthSquared();
-			float distToPlayer1 = (playerB->GetPosition() - m_position).GetLengthSquared();
-
-			if (distToPlayer0 < distToPlayer1)
-			{
-				Vec2 fwdDegrees = playerA->GetPosition() - m_position;
-				m_orientationDegrees = Atan2Degrees(fwdDegrees.y, fwdDegrees.x);
-			}
-			else
-			{
-				Vec2 fwdDegrees = playerB->GetPosition() - m_position;
-				m_orientationDegrees = Atan2Degrees(fwdDegrees.y, fwdDegrees.x);
-			}
-		}
-		else if (playerAIsValid)
-		{
-			Vec2 fwdDegrees = playerA->GetPosition() - m_position;
-			m_orientationDegrees = Atan2Degrees(fwdDegrees.y, fwdDegrees.x);
-		}
-		else if (playerBIsValid)
-		{
-			Vec2 fwdDegrees = playerB->GetPosition() - m_position;
-			m_orientationDegrees = Atan2Degrees(fwdDegrees.y, fwdDegrees.x);
-		}
-
+		Vec2 fwdDegrees = target->GetPosition() - m_position;
+		m_orientationDegrees = Atan2Degrees(fwdDegrees.y, fwdDegrees.x);
 		m_velocity = Vec2(BEETLE_SPEED * CosDegrees(m_orientationDegrees), BEETLE_SPEED * SinDegrees(m_orientationDegrees));
 	}
-	
 }
 
 
 
-void Bettle::Render() const
+void Bettle::ExtractRenderProxies(RenderSnapshot& snapshot) const
 {
-	RenderBettle();
-	RenderHealthBar();
-	
-}
-
-void Bettle::RenderBettle() const
-{
-	Vertex_PCU worldSpaceVerts[NUM_BETTLE_VERTS];
-
-	for (int vertIndex = 0; vertIndex < NUM_BETTLE_VERTS; ++vertIndex)
+	snapshot.AddProxy(m_meshId, LAYER_ENEMIES, m_position, m_orientationDegrees, m_color);
+	if (snapshot.m_showHealthBars)
 	{
-		worldSpaceVerts[vertIndex] = m_localVerts[vertIndex];
-		worldSpaceVerts[vertIndex].m_color = m_color;
+		snapshot.AddLine(LAYER_ENEMIES, Vec2(m_position.x - 2.f, m_position.y + 3.5f), Vec2(m_position.x + 2.f, m_position.y + 3.5f), 0.5f, Rgba8(255, 0, 0, 255));
+		snapshot.AddLine(LAYER_ENEMIES, Vec2(m_position.x - 2.f, m_position.y + 3.5f), Vec2(m_position.x - 2.f + (m_health * 1.f), m_position.y + 3.5f), 0.5f, Rgba8(0, 255, 0, 255));
 	}
-	TransformVertexArrayXY3D(NUM_BETTLE_VERTS, &worldSpaceVerts[0], 1.f, m_orientationDegrees, m_position);
-	g_theRenderer->DrawVertexArray(NUM_BETTLE_VERTS, &worldSpaceVerts[0]);
-}
-
-void Bettle::RenderHealthBar() const
-{
-	DebugDrawLine(Vec2(m_position.x - 2.f, m_position.y + 3.5f), Vec2(m_position.x + 2.f, m_position.y + 3.5f), 0.5f, Rgba8(255, 0, 0, 255));
-	DebugDrawLine(Vec2(m_position.x - 2.f, m_position.y + 3.5f), Vec2(m_position.x - 2.f + (m_health * 1.f), m_position.y + 3.5f), 0.5f, Rgba8(0, 255, 0, 255));
 }
 
-void Bettle::DebugRender() const
+void Bettle::ExtractDebugShapes(DebugShapeList& debugShapes) const
 {
-	DebugDrawRing(m_position, m_physicsRadius, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 255, 255));
+	debugShapes.AddRing(m_position, m_physicsRadius, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 255, 255));
 
-	DebugDrawRing(m_position, m_cosmeticRadius, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 255, 255));
+	debugShapes.AddRing(m_position, m_cosmeticRadius, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 255, 255));
 
 	Vec2 fwdCartPos = Vec2::MakeFromPolarDegrees(m_orientationDegrees, m_cosmeticRadius);
 	Vec2 fwdPos = Vec2(m_position.x + fwdCartPos.x, m_position.y + fwdCartPos.y);
-	DebugDrawLine(m_position, fwdPos, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 0, 255));
+	debugShapes.AddLine(m_position, fwdPos, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 0, 255));
 
 	Vec2 leftCartPos = Vec2::MakeFromPolarDegrees(m_orientationDegrees + 90.f, m_cosmeticRadius);
 	Vec2 leftPos = Vec2(m_position.x + leftCartPos.x, m_position.y + leftCartPos.y);
-	DebugDrawLine(m_position, leftPos, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 0, 255));
+	debugShapes.AddLine(m_position, leftPos, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 0, 255));
 
 	Vec2 velCartPos = Vec2::MakeFromPolarDegrees(Atan2Degrees(m_velocity.y, m_velocity.x), m_velocity.GetLength());
 	Vec2 velPos = Vec2(m_position.x + velCartPos.x, m_position.y + velCartPos.y);
-	DebugDrawLine(m_position, velPos, DEBUG_LINE_THICKNESS, Rgba8(255, 255, 0, 255));
+	debugShapes.AddLine(m_position, velPos, DEBUG_LINE_THICKNESS, Rgba8(255, 255, 0, 255));
 }
 
 void Bettle::Die()
 {
 	m_isDead = true;
-	m_isGarbage = true;
-	SoundID die = g_theAudio->CreateOrGetSound("Data/Audio/Die.wav");
-	g_theAudio->StartSound(die, false, 0.01f);
-	m_game->AddCameraShakeTrauma(0.1f, true);
-	m_game->AddCameraShakeTrauma(0.1f, false);
-	m_game->SpawnNewDebrisCluster(8, m_position, m_velocity, 10.f, m_physicsRadius * DEBRIS_SCALE, m_originalColor);
+	GameCommandBuffer& commands = m_game->GetCommandBuffer();
+	commands.Despawn(this);
+	commands.PlaySound(SOUND_DIE, 0.01f);
+	commands.AddCameraShake(0.1f, ALL_PLAYERS);
+	commands.SpawnDebrisCluster(8, m_position, m_velocity, 10.f, m_physicsRadius * DEBRIS_SCALE, m_originalColor);
 }
 
 void Bettle::HandleBeHitted(float deltaSeconds)
@@ -158,19 +101,3 @@ void Bettle::HandleBeHitted(float deltaSeconds)
 	}
 }
 
-
-void Bettle::InitializeLocalVerts()
-{
-	m_localVerts[0].m_position	= Vec3(2.f, 0.f, 0.f);
-	m_localVerts[2].m_position	= Vec3(-2.f, 0.f, 0.f);
-	m_localVerts[1].m_position	= Vec3(-0.5f, 2.f, 0.f);
-									   
-	m_localVerts[3].m_position	= Vec3(2.f, 0.f, 0.f);
-	m_localVerts[4].m_position	= Vec3(-2.f, 0.f, 0.f);
-	m_localVerts[5].m_position	= Vec3(-0.5f, -2.f, 0.f);
-									   
-	for (int i = 0; i < NUM_BETTLE_VERTS; ++i)
-	{
-		m_localVerts[i].m_color = m_color;
-	}
-}
@@ -16,16 +16,7 @@ public:
 	~Bullet();
 
 	virtual void Update(float deltaSeconds) override;
-	virtual void Render() const override;
-	virtual void DebugRender() const override;
+	virtual void ExtractRenderProxies(RenderSnapshot& snapshot) const override;
+	virtual void ExtractDebugShapes(DebugShapeList& debugShapes) const override;
 	virtual void Die() override;
-
-
-private:
-	void InitializeLocalVerts();
-
-private:
-	Vertex_PCU m_localVerts[NUM_BULLET_VERTS];
-
-
 };
\ No newline at end of file
@@ -1,25 +1,38 @@
 #include "Debris.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/MeshLibrary.hpp"
 #include "Game/Game.hpp"
 #include "Engine/Core/Clock.hpp"
 #include <Engine/Core/VertexUtils.hpp>
 
-Debris::Debris(Game* owner, Vec2 const& startPos, Vec2 const& velocity, float radius, Rgba8 color)
-	: Entity(owner, startPos, owner->m_rng->RollRandomFloatInRange(0.f, 360.f), color)
+Debris::Debris(Game* owner, Vec2 const& startPos, Vec2 const& velocity, float radius, Rgba8 color, DebrisRolls const& rolls)
+	: Entity(owner, startPos, rolls.m_orientationDegrees, color)
 {
 	m_cosmeticRadius = radius * 1.5f;
 	m_physicsRadius = radius * 0.5f;
 	m_health = 1;
 	m_velocity = velocity;
-	m_angularVeclocity = owner->m_rng->RollRandomFloatInRange(-200.f, 200.f);
-	m_velocity = Vec2(owner->m_rng->RollRandomFloatInRange(-20.f, 20.f), owner->m_rng->RollRandomFloatInRange(-20.f, 20.f));
+	m_angularVeclocity = rolls.m_angularVelocity;
+	m_velocity = rolls.m_driftVelocity;
 	m_color = color;
-	InitializeLocalVerts();
+	m_meshId = static_cast<unsigned short>(MESH_DEBRIS_FIRST + rolls.m_meshVariant);
 }
 
 Debris::~Debris()
 {
 }
 
+DebrisRolls Debris::RollDebris(RandomNumberGenerator* rng)
+{
+	DebrisRolls rolls;
+	rolls.m_orientationDegrees = rng->RollRandomFloatInRange(0.f, 360.f);
+	rolls.m_angularVelocity = rng->RollRandomFloatInRange(-200.f, 200.f);
+	rolls.m_driftVelocity.x = rng->RollRandomFloatInRange(-20.f, 20.f);
+	rolls.m_driftVelocity.y = rng->RollRandomFloatInRange(-20.f, 20.f);
+	rolls.m_meshVariant = rng->RollRandomIntInRange(0, NUM_DEBRIS_MESH_VARIANTS - 1);
+	return rolls;
+}
+
 void Debris::Update(float deltaSeconds)
 {
 
@@ -36,45 +49,38 @@ void Debris::Update(float deltaSeconds)
 	
 }
 
-void Debris::Render() const
+void Debris::ExtractRenderProxies(RenderSnapshot& snapshot) const
 {
-	g_theRenderer->SetBlendMode(BlendMode::ALPHA);
-
-	Vertex_PCU tempWorldVerts[NUM_DEBRIS_VERTS];
-	for (int vertIndex = 0; vertIndex < NUM_DEBRIS_VERTS; ++vertIndex)
-	{
-		tempWorldVerts[vertIndex] = m_localVerts[vertIndex];
-
-		float alpha = RangeMapClamped(m_ageInSeconds, 0.f, 2.f, 127.f, 0.f);
-		Rgba8 colorNow = m_color;
-		colorNow.a = static_cast<unsigned char> (alpha);
-		
-		tempWorldVerts[vertIndex].m_color = colorNow;
-	}
+	float alpha = RangeMapClamped(m_ageInSeconds, 0.f, 2.f, 127.f, 0.f);
+	Rgba8 colorNow = m_color;
+	colorNow.a = static_cast<unsigned char> (alpha);
 
-	TransformVertexArrayXY3D(NUM_DEBRIS_VERTS, &tempWorldVerts[0], 1.f, m_orientationDegrees, m_position);
-	
-	
-	g_theRenderer->DrawVertexArray(NUM_DEBRIS_VERTS, &tempWorldVerts[0]);
+	RenderProxy& proxy = snapshot.AddProxy(m_meshId, LAYER_DEBRIS, m_position, m_orientationDegrees, colorNow);
+	float radius = m_physicsRadius * 2.f;
+	proxy.m_scale = Vec2(radius, radius);
 }
 
-void Debris::DebugRender() const
+void Debris::ExtractDebugShapes(DebugShapeList& debugShapes) const
 {
+	UNUSED(debugShapes);
 }
 
 void Debris::Die()
 {
 	m_isDead = true;
-	m_isGarbage = true;
+	m_game->GetCommandBuffer().Despawn(this);
 }
 
-void Debris::InitializeLocalVerts()
+//-----------------------------------------------------------------------------------------------
+// Unit-radius debris, scaled by each instance's radius. Same fan layout as
+// Asteroid::InitializeVerts: center first, then the rim.
+//
+void Debris::InitializeVerts(Vertex_PCU* vertsToFillIn, unsigned int* indexesToFillIn, RandomNumberGenerator& rng)
 {
-	RandomNumberGenerator m_rng;
 	float debrisLens[NUM_STARS_TRIS] = {};
 	for (int debSideIndex = 0; debSideIndex < NUM_STARS_TRIS; ++debSideIndex)
 	{
-		float randomLen = m_rng.RollRandomFloatInRange(m_physicsRadius, m_cosmeticRadius);
+		float randomLen = rng.RollRandomFloatInRange(0.5f, 1.5f);
 		debrisLens[debSideIndex] = randomLen;
 	}
 
@@ -86,25 +92,21 @@ void Debris::InitializeLocalVerts()
 		debrisDegs[debrisDegIndex] = degrees;
 	}
 
+	vertsToFillIn[0].m_position = Vec3(0.f, 0.f, 0.f);
+	vertsToFillIn[0].m_color = Rgba8(255, 255, 255, 255);
+
 	for (int debrisPosIndex = 0; debrisPosIndex < NUM_STARS_TRIS; ++debrisPosIndex)
 	{
-		int firstVertIndex = debrisPosIndex;
-		int lastVertIndex = (debrisPosIndex + 1) % NUM_STARS_TRIS;
-
-		Vec3 firstPos = GetDebrisVertex(debrisLens[firstVertIndex], debrisDegs[firstVertIndex]);
-		Vec3 lastPos = GetDebrisVertex(debrisLens[lastVertIndex], debrisDegs[lastVertIndex]);
+		vertsToFillIn[debrisPosIndex + 1].m_position = GetDebrisVertex(debrisLens[debrisPosIndex], debrisDegs[debrisPosIndex]);
+		vertsToFillIn[debrisPosIndex + 1].m_color = Rgba8(255, 255, 255, 255);
 
 		int first = debrisPosIndex * 3;
 		int second = debrisPosIndex * 3 + 1;
 		int third = debrisPosIndex * 3 + 2;
 
-		m_localVerts[first].m_position = firstPos;
-		m_localVerts[third].m_position = Vec3(0.f, 0.f, 0.f);
-		m_localVerts[second].m_position = lastPos;
-
-		m_localVerts[first].m_color = m_color;
-		m_localVerts[third].m_color = m_color;
-		m_localVerts[second].m_color = m_color;
+		indexesToFillIn[first] = debrisPosIndex + 1;
+		indexesToFillIn[second] = (debrisPosIndex + 1) % NUM_STARS_TRIS + 1;
+		indexesToFillIn[third] = 0;
 	}
 }
 
@@ -5,27 +5,41 @@
 
 
 class Game;
+class RandomNumberGenerator;
 
 constexpr int NUM_STARS_TRIS = 8;
-constexpr int NUM_DEBRIS_VERTS = 3 * NUM_STARS_TRIS;
+constexpr int NUM_DEBRIS_VERTS = NUM_STARS_TRIS + 1;
+constexpr int NUM_DEBRIS_INDEXES = 3 * NUM_STARS_TRIS;
+
+//-----------------------------------------------------------------------------------------------
+// Everything a debris piece takes from the game RNG, rolled before the piece is constructed so a
+// cluster can roll for pieces it then does not spawn.
+//
+struct DebrisRolls
+{
+	float	m_orientationDegrees = 0.f;
+	float	m_angularVelocity = 0.f;
+	Vec2	m_driftVelocity;
+	int		m_meshVariant = 0;
+};
 
 class Debris : public Entity
 {
 public:
-	Debris(Game* owner, Vec2 const& startPos, Vec2 const& velocity, float radius, Rgba8 color);
+	Debris(Game* owner, Vec2 const& startPos, Vec2 const& velocity, float radius, Rgba8 color, DebrisRolls const& rolls);
 	~Debris();
 
 	virtual void Update(float deltaSeconds) override;
-	virtual void Render() const override;
-	virtual void DebugRender() const override;
+	virtual void ExtractRenderProxies(RenderSnapshot& snapshot) const override;
+	virtual void ExtractDebugShapes(DebugShapeList& debugShapes) const override;
 	virtual void Die() override;
 
-private:
-	void InitializeLocalVerts();
+	static DebrisRolls RollDebris(RandomNumberGenerator* rng);
+	static void InitializeVerts(Vertex_PCU* vertsToFillIn, unsigned int* indexesToFillIn, RandomNumberGenerator& rng);
 
-	Vec3 GetDebrisVertex(float lens, float degrees);
+private:
+	static Vec3 GetDebrisVertex(float lens, float degrees);
 
 private:
-	Vertex_PCU m_localVerts[NUM_DEBRIS_VERTS];
 	Rgba8	m_color;
 };
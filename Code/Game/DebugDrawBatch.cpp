@@ -0,0 +1,184 @@
+#include "Game/DebugDrawBatch.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/RenderBackend.hpp"
+
+extern RenderBackend* g_theRenderBackend;
+
+//-----------------------------------------------------------------------------------------------
+// (cos, sin) of DEBUG_RING_MAX_SIDES evenly spaced angles, plus a copy of the first so a side
+// never has to wrap its end index.
+//
+static Vec2 s_unitCircle[DEBUG_RING_MAX_SIDES + 1];
+
+DebugDrawBatch::DebugDrawBatch()
+{
+	if (s_unitCircle[0].x == 0.f)
+	{
+		constexpr float DEGREES_PER_SIDE = 360.f / static_cast<float>(DEBUG_RING_MAX_SIDES);
+		for (int sideNum = 0; sideNum < DEBUG_RING_MAX_SIDES; ++sideNum)
+		{
+			float degrees = DEGREES_PER_SIDE * static_cast<float>(sideNum);
+			s_unitCircle[sideNum] = Vec2(CosDegrees(degrees), SinDegrees(degrees));
+		}
+		s_unitCircle[DEBUG_RING_MAX_SIDES] = s_unitCircle[0];
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Starts a new batch. viewportWidthPixels is how wide viewBounds ends up on screen; it decides
+// how many sides rings get.
+//
+void DebugDrawBatch::BeginView(AABB2 const& viewBounds, float viewportWidthPixels)
+{
+	m_verts.clear();
+	m_viewBounds = viewBounds;
+	m_pixelsPerWorldUnit = viewportWidthPixels / (viewBounds.m_maxs.x - viewBounds.m_mins.x);
+}
+
+void DebugDrawBatch::AddRing(Vec2 const& center, float radius, float thickness, Rgba8 const& color)
+{
+	float halfThickness = 0.5f * thickness;
+	float innerRadius = radius - halfThickness;
+	float outerRadius = radius + halfThickness;
+	if (IsOutsideView(Vec2(center.x - outerRadius, center.y - outerRadius), Vec2(center.x + outerRadius, center.y + outerRadius)))
+	{
+		return;
+	}
+
+	int numSides = GetNumRingSides(radius);
+	int stride = DEBUG_RING_MAX_SIDES / numSides;
+
+	size_t firstVert = m_verts.size();
+	m_verts.resize(firstVert + 6 * numSides);
+	Vertex_PCU* sideVerts = &m_verts[firstVert];
+	for (int sideNum = 0; sideNum < numSides; ++sideNum)
+	{
+		Vec2 const& startDir = s_unitCircle[sideNum * stride];
+		Vec2 const& endDir = s_unitCircle[(sideNum + 1) * stride];
+		Vec3 innerStart(center.x + innerRadius * startDir.x, center.y + innerRadius * startDir.y, 0.f);
+		Vec3 outerStart(center.x + outerRadius * startDir.x, center.y + outerRadius * startDir.y, 0.f);
+		Vec3 innerEnd(center.x + innerRadius * endDir.x, center.y + innerRadius * endDir.y, 0.f);
+		Vec3 outerEnd(center.x + outerRadius * endDir.x, center.y + outerRadius * endDir.y, 0.f);
+
+		sideVerts[0].m_position = innerEnd;
+		sideVerts[1].m_position = innerStart;
+		sideVerts[2].m_position = outerStart;
+
+		sideVerts[3].m_position = innerEnd;
+		sideVerts[4].m_position = outerStart;
+		sideVerts[5].m_position = outerEnd;
+
+		for (int vertIndex = 0; vertIndex < 6; ++vertIndex)
+		{
+			sideVerts[vertIndex].m_color = color;
+		}
+		sideVerts += 6;
+	}
+}
+
+void DebugDrawBatch::AddLine(Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color)
+{
+	float halfThickness = 0.5f * thickness;
+	Vec2 mins(startPos.x < endPos.x ? startPos.x : endPos.x, startPos.y < endPos.y ? startPos.y : endPos.y);
+	Vec2 maxs(startPos.x > endPos.x ? startPos.x : endPos.x, startPos.y > endPos.y ? startPos.y : endPos.y);
+	if (IsOutsideView(Vec2(mins.x - halfThickness, mins.y - halfThickness), Vec2(maxs.x + halfThickness, maxs.y + halfThickness)))
+	{
+		return;
+	}
+
+	AddVertsForLine2D(m_verts, startPos, endPos, thickness, color);
+}
+
+void DebugDrawBatch::Flush()
+{
+	if (m_verts.empty())
+	{
+		return;
+	}
+
+	g_theRenderBackend->BindTexture(nullptr);
+	g_theRenderBackend->DrawVertexArray(static_cast<int>(m_verts.size()), m_verts.data());
+	m_verts.clear();
+}
+
+bool DebugDrawBatch::IsOutsideView(Vec2 const& mins, Vec2 const& maxs) const
+{
+	return maxs.x < m_viewBounds.m_mins.x || mins.x > m_viewBounds.m_maxs.x || maxs.y < m_viewBounds.m_mins.y || mins.y > m_viewBounds.m_maxs.y;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Doubles from DEBUG_RING_MIN_SIDES until each side is at most DEBUG_RING_PIXELS_PER_SIDE long
+// on screen (scaled by the detail scale), capped at DEBUG_RING_MAX_SIDES.
+//
+int DebugDrawBatch::GetNumRingSides(float radius) const
+{
+	constexpr float TWO_PI = 6.2831853f;
+	float circumferencePixels = TWO_PI * radius * m_pixelsPerWorldUnit * m_detailScale;
+
+	int numSides = DEBUG_RING_MIN_SIDES;
+	while (numSides < DEBUG_RING_MAX_SIDES && static_cast<float>(numSides) * DEBUG_RING_PIXELS_PER_SIDE < circumferencePixels)
+	{
+		numSides *= 2;
+	}
+	return numSides;
+}
+
+void DebugShapeList::AddRing(Vec2 const& center, float radius, float thickness, Rgba8 const& color)
+{
+	DebugShape shape;
+	shape.m_start = center;
+	shape.m_end = center;
+	shape.m_radius = radius;
+	shape.m_thickness = thickness;
+	shape.m_color = color;
+	m_shapes.push_back(shape);
+}
+
+void DebugShapeList::AddLine(Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color)
+{
+	DebugShape shape;
+	shape.m_start = startPos;
+	shape.m_end = endPos;
+	shape.m_radius = 0.f;
+	shape.m_thickness = thickness;
+	shape.m_color = color;
+	m_shapes.push_back(shape);
+}
+
+void DebugShapeList::AddTo(DebugDrawBatch& debugDraw) const
+{
+	for (int shapeIndex = 0; shapeIndex < static_cast<int>(m_shapes.size()); ++shapeIndex)
+	{
+		DebugShape const& shape = m_shapes[shapeIndex];
+		if (shape.m_radius > 0.f)
+		{
+			debugDraw.AddRing(shape.m_start, shape.m_radius, shape.m_thickness, shape.m_color);
+		}
+		else
+		{
+			debugDraw.AddLine(shape.m_start, shape.m_end, shape.m_thickness, shape.m_color);
+		}
+	}
+}
+
+bool DebugShapeList::IsSameAs(DebugShapeList const& other) const
+{
+	if (m_shapes.size() != other.m_shapes.size())
+	{
+		return false;
+	}
+
+	for (int shapeIndex = 0; shapeIndex < static_cast<int>(m_shapes.size()); ++shapeIndex)
+	{
+		DebugShape const& shape = m_shapes[shapeIndex];
+		DebugShape const& otherShape = other.m_shapes[shapeIndex];
+		bool isSameShape = shape.m_start == otherShape.m_start && shape.m_end == otherShape.m_end && shape.m_radius == otherShape.m_radius &&
+						   shape.m_thickness == otherShape.m_thickness && shape.m_color == otherShape.m_color;
+		if (!isSameShape)
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include <vector>
+
+constexpr int DEBUG_RING_MIN_SIDES = 8;
+constexpr int DEBUG_RING_MAX_SIDES = 64;				// must be DEBUG_RING_MIN_SIDES times a power of two
+constexpr float DEBUG_RING_PIXELS_PER_SIDE = 8.f;		// on-screen length a ring side may grow to before the ring subdivides
+
+//-----------------------------------------------------------------------------------------------
+// Accumulates the F1 debug shapes for one view and draws them in a single call. Shapes entirely
+// outside the view are dropped when added. Rings walk one precomputed unit circle with a stride,
+// using just enough sides for their radius on screen: small rings get DEBUG_RING_MIN_SIDES, large
+// ones up to DEBUG_RING_MAX_SIDES. The vertex array keeps its capacity between views and frames.
+//
+class DebugDrawBatch
+{
+public:
+	DebugDrawBatch();
+
+	void BeginView(AABB2 const& viewBounds, float viewportWidthPixels);
+	void AddRing(Vec2 const& center, float radius, float thickness, Rgba8 const& color);
+	void AddLine(Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color);
+	void Flush();
+
+	void SetDetailScale(float detailScale) { m_detailScale = detailScale; }	// quality knob: below 1 gives rings fewer sides
+	int GetNumVerts() const { return static_cast<int>(m_verts.size()); }
+
+private:
+	bool IsOutsideView(Vec2 const& mins, Vec2 const& maxs) const;
+	int GetNumRingSides(float radius) const;
+
+private:
+	std::vector<Vertex_PCU>	m_verts;
+	AABB2					m_viewBounds;
+	float					m_pixelsPerWorldUnit = 1.f;
+	float					m_detailScale = 1.f;
+};
+
+//-----------------------------------------------------------------------------------------------
+// F1 shapes recorded on the sim thread with the rest of a RenderSnapshot, so they are drawn with
+// the meshes of the same tick. AddTo feeds them to a DebugDrawBatch for one view.
+//
+class DebugShapeList
+{
+public:
+	void Clear() { m_shapes.clear(); }
+	void AddRing(Vec2 const& center, float radius, float thickness, Rgba8 const& color);
+	void AddLine(Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color);
+	void AddTo(DebugDrawBatch& debugDraw) const;
+
+	bool IsEmpty() const { return m_shapes.empty(); }
+	bool IsSameAs(DebugShapeList const& other) const;
+
+private:
+	struct DebugShape
+	{
+		Vec2	m_start;		// ring center
+		Vec2	m_end;
+		float	m_radius;		// 0 for lines
+		float	m_thickness;
+		Rgba8	m_color;
+	};
+
+	std::vector<DebugShape>	m_shapes;
+};
@@ -3,14 +3,14 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/GameCommon.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
+#include "Game/Game.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include <math.h>
 
-extern AudioSystem* g_theAudio;
 Entity::Entity(Game* owner, Vec2 const& startPos, float orientationDeg, Rgba8 color)
 	: m_game(owner)
 	, m_position(startPos)
+	, m_lastPosition(startPos)
 	, m_orientationDegrees(orientationDeg)
 	, m_color(color)
 {
@@ -31,13 +31,14 @@ void Entity::Update(float deltaSeconds)
 	UNUSED(deltaSeconds);
 }
 
-void Entity::Render() const
+void Entity::ExtractRenderProxies(RenderSnapshot& snapshot) const
 {
-
+	UNUSED(snapshot);
 }
 
-void Entity::DebugRender() const
+void Entity::ExtractDebugShapes(DebugShapeList& debugShapes) const
 {
+	UNUSED(debugShapes);
 }
 
 void Entity::Die()
@@ -51,8 +52,7 @@ void Entity::BeHitted()
 	m_isHitted = true;
 	m_color = Rgba8(255, 51, 51, 255);
 	m_hittedTimer = 0.f;
-	SoundID beHitted = g_theAudio->CreateOrGetSound("Data/Audio/BeHitted.wav");
-	g_theAudio->StartSound(beHitted, false, 0.1f);
+	m_game->GetCommandBuffer().PlaySound(SOUND_BE_HITTED, 0.1f);
 }
 
 bool Entity::IsOffscreen() const
@@ -3,7 +3,9 @@
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Clock.hpp"
 
+class DebugShapeList;
 class Game;
+class RenderSnapshot;
 
 class Entity
 {
@@ -12,8 +14,8 @@ public:
 	virtual ~Entity();
 
 	virtual void Update(float deltaSeconds) = 0;
-	virtual void Render() const = 0;
-	virtual void DebugRender() const = 0;
+	virtual void ExtractRenderProxies(RenderSnapshot& snapshot) const = 0;
+	virtual void ExtractDebugShapes(DebugShapeList& debugShapes) const = 0;
 	virtual void Die();
 
 	void BeHitted();
@@ -22,18 +24,26 @@ public:
 	Vec2 GetForwardNormal() const;
 
 	void PushOutOfEntity(Entity* other);
+	void RecordLastPosition() { m_lastPosition = m_position; }
 	bool IsAlive() const { return !m_isDead; }
 	Game* GetGame() const { return m_game; }
 
 	Vec2 GetPosition() const { return m_position; }
+	Vec2 GetLastPosition() const { return m_lastPosition; }
+	void SetPosition(Vec2 const& position) { m_position = position; }
 	float GetPhysicsRadius() const { return m_physicsRadius; }
+	float GetCosmeticRadius() const { return m_cosmeticRadius; }
 	int GetHealth() const { return m_health; }
 	bool GetIsGarbage() { return m_isGarbage; }
+	void MarkAsGarbage() { m_isGarbage = true; }
+	unsigned char GetViewLods() const { return m_viewLods; }
+	void SetViewLods(unsigned char viewLods) { m_viewLods = viewLods; }
 	
 protected:
 	Game*	m_game					= nullptr;
 
 	Vec2	m_position;
+	Vec2	m_lastPosition;
 	Vec2	m_velocity;
 	Rgba8	m_color;
 	Rgba8   m_originalColor;
@@ -49,6 +59,8 @@ protected:
 	float	m_hitColorDuration = 0.2f;
 	
 	int		m_health;
+	unsigned short	m_meshId		= 0;
+	unsigned char	m_viewLods		= 0;	// mesh LOD per render view, as in RenderProxy::m_viewLods
 	bool	m_isDead				= false;
 	bool	m_isGarbage				= false;
 	bool	m_isHitted				= false;
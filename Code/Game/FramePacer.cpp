@@ -0,0 +1,131 @@
+#include "Game/FramePacer.hpp"
+#include <thread>
+
+static double GetSecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+	return std::chrono::duration<double>(end - start).count();
+}
+
+FramePacer::FramePacer()
+{
+	m_frameStart = PacerClock::now();
+	m_nextDeadline = m_frameStart;
+}
+
+void FramePacer::SetTargetFrameRate(FramePacingMode mode, float framesPerSecond)
+{
+	m_targetFrameRates[mode] = framesPerSecond > 0.f ? framesPerSecond : 0.f;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Call once per frame, after presenting. Returns at the start of the next frame.
+//
+void FramePacer::EndFrame(FramePacingMode mode)
+{
+	m_lastWorkSeconds = GetSecondsBetween(m_frameStart, PacerClock::now());
+	float framesPerSecond = m_targetFrameRates[mode];
+	if (framesPerSecond > 0.f)
+	{
+		PacerClock::duration period = std::chrono::duration_cast<PacerClock::duration>(std::chrono::duration<double>(1.0 / static_cast<double>(framesPerSecond)));
+		m_nextDeadline += period;
+
+		PacerClock::time_point now = PacerClock::now();
+		if (now > m_nextDeadline + period)
+		{
+			m_nextDeadline = now;
+		}
+		else
+		{
+			WaitUntil(m_nextDeadline);
+		}
+	}
+
+	PacerClock::time_point frameEnd = PacerClock::now();
+	if (framesPerSecond <= 0.f)
+	{
+		m_nextDeadline = frameEnd;
+	}
+	m_lastFrameSeconds = GetSecondsBetween(m_frameStart, frameEnd);
+	RecordFrame(m_lastFrameSeconds);
+	m_frameStart = frameEnd;
+}
+
+void FramePacer::WaitUntil(PacerClock::time_point deadline)
+{
+	std::chrono::duration<double> const sleepRequest(FRAME_PACER_SLEEP_SECONDS);
+	for (;;)
+	{
+		PacerClock::time_point beforeSleep = PacerClock::now();
+		if (GetSecondsBetween(beforeSleep, deadline) <= FRAME_PACER_SLEEP_SECONDS + m_sleepOvershootSeconds)
+		{
+			break;
+		}
+
+		std::this_thread::sleep_for(sleepRequest);
+		double overshootSeconds = GetSecondsBetween(beforeSleep, PacerClock::now()) - FRAME_PACER_SLEEP_SECONDS;
+		if (overshootSeconds > m_sleepOvershootSeconds)
+		{
+			m_sleepOvershootSeconds = overshootSeconds;
+		}
+		else
+		{
+			m_sleepOvershootSeconds += 0.01 * (overshootSeconds - m_sleepOvershootSeconds);
+		}
+	}
+
+	while (PacerClock::now() < deadline)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void FramePacer::RecordFrame(double frameSeconds)
+{
+	int bucketIndex = static_cast<int>(frameSeconds / FRAME_TIME_BUCKET_SECONDS);
+	if (bucketIndex >= FRAME_TIME_HISTOGRAM_BUCKETS)
+	{
+		bucketIndex = FRAME_TIME_HISTOGRAM_BUCKETS - 1;
+	}
+	++m_histogram[bucketIndex];
+	++m_numFrames;
+	m_totalFrameSeconds += frameSeconds;
+	if (frameSeconds > m_maxFrameSeconds)
+	{
+		m_maxFrameSeconds = frameSeconds;
+	}
+}
+
+void FramePacer::ResetHistogram()
+{
+	for (int bucketIndex = 0; bucketIndex < FRAME_TIME_HISTOGRAM_BUCKETS; ++bucketIndex)
+	{
+		m_histogram[bucketIndex] = 0;
+	}
+	m_numFrames = 0;
+	m_totalFrameSeconds = 0.0;
+	m_maxFrameSeconds = 0.0;
+}
+
+double FramePacer::GetMeanFrameSeconds() const
+{
+	return m_numFrames > 0 ? m_totalFrameSeconds / static_cast<double>(m_numFrames) : 0.0;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Upper edge of the bucket the percentile falls in, so accurate to FRAME_TIME_BUCKET_SECONDS.
+// percentile is in [0, 100].
+//
+double FramePacer::GetFrameSecondsAtPercentile(float percentile) const
+{
+	int rank = static_cast<int>(static_cast<double>(percentile) * 0.01 * static_cast<double>(m_numFrames));
+	int numCounted = 0;
+	for (int bucketIndex = 0; bucketIndex < FRAME_TIME_HISTOGRAM_BUCKETS; ++bucketIndex)
+	{
+		numCounted += m_histogram[bucketIndex];
+		if (numCounted > rank)
+		{
+			return static_cast<double>(bucketIndex + 1) * FRAME_TIME_BUCKET_SECONDS;
+		}
+	}
+	return m_maxFrameSeconds;
+}
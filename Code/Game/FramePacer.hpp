@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+
+//-----------------------------------------------------------------------------------------------
+// What the app is showing, each with its own frame rate cap.
+//
+enum FramePacingMode
+{
+	FRAME_PACING_GAMEPLAY,
+	FRAME_PACING_PAUSED,
+	FRAME_PACING_ATTRACT,
+	NUM_FRAME_PACING_MODES
+};
+
+constexpr int FRAME_TIME_HISTOGRAM_BUCKETS = 100;
+constexpr double FRAME_TIME_BUCKET_SECONDS = 0.0005;		// the last bucket also holds every slower frame
+constexpr double FRAME_PACER_SLEEP_SECONDS = 0.001;			// length of each sleep request while waiting
+constexpr double FRAME_PACER_INITIAL_OVERSLEEP_SECONDS = 0.001;
+
+//-----------------------------------------------------------------------------------------------
+// Caps the main loop at a target frame rate and keeps a histogram of frame times.
+//
+// EndFrame waits out the rest of the frame period. It sleeps in FRAME_PACER_SLEEP_SECONDS steps
+// while that cannot overshoot the deadline, then spins for the remainder. How far a sleep runs
+// late is learned as it goes: the estimate jumps to any worse overshoot and decays slowly, so a
+// coarse OS timer just means more spinning, never a late frame. Deadlines advance by whole
+// periods, so the average rate holds; after a frame that ran more than a period over, pacing
+// restarts from that frame instead of rushing to catch up.
+//
+// Only std::chrono and std::this_thread are used, so it behaves the same on every platform.
+//
+class FramePacer
+{
+public:
+	FramePacer();
+
+	void SetTargetFrameRate(FramePacingMode mode, float framesPerSecond);	// 0 runs uncapped
+	float GetTargetFrameRate(FramePacingMode mode) const { return m_targetFrameRates[mode]; }
+	void EndFrame(FramePacingMode mode);
+
+	void ResetHistogram();
+	int GetNumFrames() const { return m_numFrames; }
+	int GetHistogramCount(int bucketIndex) const { return m_histogram[bucketIndex]; }
+	double GetMeanFrameSeconds() const;
+	double GetMaxFrameSeconds() const { return m_maxFrameSeconds; }
+	double GetFrameSecondsAtPercentile(float percentile) const;
+	double GetSleepOvershootSeconds() const { return m_sleepOvershootSeconds; }
+	double GetLastWorkSeconds() const { return m_lastWorkSeconds; }		// last frame up to EndFrame, without the wait
+	double GetLastFrameSeconds() const { return m_lastFrameSeconds; }
+
+private:
+	using PacerClock = std::chrono::steady_clock;
+
+	void WaitUntil(PacerClock::time_point deadline);
+	void RecordFrame(double frameSeconds);
+
+private:
+	float					m_targetFrameRates[NUM_FRAME_PACING_MODES] = {};
+	PacerClock::time_point	m_frameStart;
+	PacerClock::time_point	m_nextDeadline;
+	double					m_sleepOvershootSeconds = FRAME_PACER_INITIAL_OVERSLEEP_SECONDS;
+	double					m_lastWorkSeconds = 0.0;
+	double					m_lastFrameSeconds = 0.0;
+
+	int						m_histogram[FRAME_TIME_HISTOGRAM_BUCKETS] = {};
+	int						m_numFrames = 0;
+	double					m_totalFrameSeconds = 0.0;
+	double					m_maxFrameSeconds = 0.0;
+};
@@ -0,0 +1,145 @@
+#include "Game/FrameRecorder.hpp"
+
+//-----------------------------------------------------------------------------------------------
+// Drops the previous recording, keeping its capacity, and forwards from now on to target.
+//
+void FrameRecorder::BeginRecording(RenderBackend* target)
+{
+	m_target = target;
+	m_commands.clear();
+	m_cameras.clear();
+	m_viewports.clear();
+	m_verts.clear();
+	m_indexes.clear();
+}
+
+void FrameRecorder::EndRecording()
+{
+	m_target = nullptr;
+}
+
+void FrameRecorder::Replay(RenderBackend& target) const
+{
+	for (int commandIndex = 0; commandIndex < static_cast<int>(m_commands.size()); ++commandIndex)
+	{
+		FrameCommand const& command = m_commands[commandIndex];
+		switch (command.m_type)
+		{
+		case FRAME_CLEAR_SCREEN:
+			target.ClearScreen(command.m_clearColor);
+			break;
+		case FRAME_BEGIN_CAMERA:
+			target.BeginCamera(m_cameras[command.m_cameraIndex]);
+			break;
+		case FRAME_END_CAMERA:
+			target.EndCamera(m_cameras[command.m_cameraIndex]);
+			break;
+		case FRAME_SET_VIEWPORT:
+			target.SetViewport(m_viewports[command.m_viewportIndex]);
+			break;
+		case FRAME_SET_BLEND_MODE:
+			target.SetBlendMode(command.m_blendMode);
+			break;
+		case FRAME_BIND_TEXTURE:
+			target.BindTexture(command.m_texture);
+			break;
+		case FRAME_DRAW:
+			target.DrawVertexArray(command.m_numVerts, &m_verts[command.m_firstVert]);
+			break;
+		case FRAME_DRAW_INDEXED:
+			target.DrawIndexedVertexArray(command.m_numVerts, &m_verts[command.m_firstVert], command.m_numIndexes, &m_indexes[command.m_firstIndex]);
+			break;
+		}
+	}
+}
+
+void FrameRecorder::ClearScreen(Rgba8 const& clearColor)
+{
+	FrameCommand command;
+	command.m_type = FRAME_CLEAR_SCREEN;
+	command.m_clearColor = clearColor;
+	m_commands.push_back(command);
+	m_target->ClearScreen(clearColor);
+}
+
+void FrameRecorder::BeginCamera(Camera const& camera)
+{
+	FrameCommand command;
+	command.m_type = FRAME_BEGIN_CAMERA;
+	command.m_cameraIndex = AddCamera(camera);
+	m_commands.push_back(command);
+	m_target->BeginCamera(camera);
+}
+
+void FrameRecorder::EndCamera(Camera const& camera)
+{
+	FrameCommand command;
+	command.m_type = FRAME_END_CAMERA;
+	command.m_cameraIndex = AddCamera(camera);
+	m_commands.push_back(command);
+	m_target->EndCamera(camera);
+}
+
+void FrameRecorder::SetViewport(ViewportData const& viewport)
+{
+	FrameCommand command;
+	command.m_type = FRAME_SET_VIEWPORT;
+	command.m_viewportIndex = static_cast<int>(m_viewports.size());
+	m_viewports.push_back(viewport);
+	m_commands.push_back(command);
+	m_target->SetViewport(viewport);
+}
+
+void FrameRecorder::SetBlendMode(BlendMode blendMode)
+{
+	FrameCommand command;
+	command.m_type = FRAME_SET_BLEND_MODE;
+	command.m_blendMode = blendMode;
+	m_commands.push_back(command);
+	m_target->SetBlendMode(blendMode);
+}
+
+void FrameRecorder::BindTexture(Texture const* texture)
+{
+	FrameCommand command;
+	command.m_type = FRAME_BIND_TEXTURE;
+	command.m_texture = texture;
+	m_commands.push_back(command);
+	m_target->BindTexture(texture);
+}
+
+void FrameRecorder::DrawVertexArray(int numVerts, Vertex_PCU const* verts)
+{
+	FrameCommand command;
+	command.m_type = FRAME_DRAW;
+	command.m_firstVert = static_cast<int>(m_verts.size());
+	command.m_numVerts = numVerts;
+	m_verts.insert(m_verts.end(), verts, verts + numVerts);
+	m_commands.push_back(command);
+	m_target->DrawVertexArray(numVerts, verts);
+}
+
+void FrameRecorder::DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes)
+{
+	FrameCommand command;
+	command.m_type = FRAME_DRAW_INDEXED;
+	command.m_firstVert = static_cast<int>(m_verts.size());
+	command.m_numVerts = numVerts;
+	command.m_firstIndex = static_cast<int>(m_indexes.size());
+	command.m_numIndexes = numIndexes;
+	m_verts.insert(m_verts.end(), verts, verts + numVerts);
+	m_indexes.insert(m_indexes.end(), indexes, indexes + numIndexes);
+	m_commands.push_back(command);
+	m_target->DrawIndexedVertexArray(numVerts, verts, numIndexes, indexes);
+}
+
+void FrameRecorder::EndFrame()
+{
+	m_target->EndFrame();
+}
+
+int FrameRecorder::AddCamera(Camera const& camera)
+{
+	m_cameras.push_back(camera);
+	return static_cast<int>(m_cameras.size()) - 1;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Game/RenderBackend.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include <vector>
+
+//-----------------------------------------------------------------------------------------------
+// RenderBackend that passes every call on to a target backend and keeps a copy of it, vertices
+// included, so the same frame can be submitted again later without rebuilding anything. Game
+// records frames that are likely to repeat (a paused game, the attract screen) and replays the
+// recording for as long as nothing on screen changes.
+//
+// Only calls made through the RenderBackend interface are captured; anything drawn straight
+// through g_theRenderer is not part of the recording.
+//
+class FrameRecorder : public RenderBackend
+{
+public:
+	void BeginRecording(RenderBackend* target);
+	void EndRecording();
+	void Replay(RenderBackend& target) const;
+
+	virtual void ClearScreen(Rgba8 const& clearColor) override;
+	virtual void BeginCamera(Camera const& camera) override;
+	virtual void EndCamera(Camera const& camera) override;
+	virtual void SetViewport(ViewportData const& viewport) override;
+	virtual void SetBlendMode(BlendMode blendMode) override;
+	virtual void BindTexture(Texture const* texture) override;
+	virtual void DrawVertexArray(int numVerts, Vertex_PCU const* verts) override;
+	virtual void DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes) override;
+	virtual void EndFrame() override;
+
+	int GetNumRecordedVerts() const { return static_cast<int>(m_verts.size()); }
+
+private:
+	enum FrameCommandType : unsigned char
+	{
+		FRAME_CLEAR_SCREEN,
+		FRAME_BEGIN_CAMERA,
+		FRAME_END_CAMERA,
+		FRAME_SET_VIEWPORT,
+		FRAME_SET_BLEND_MODE,
+		FRAME_BIND_TEXTURE,
+		FRAME_DRAW,
+		FRAME_DRAW_INDEXED
+	};
+
+	//-----------------------------------------------------------------------------------------------
+	// Cameras, viewports, vertices and indexes live in the recorder's own arrays; m_first* and
+	// m_num* select this command's part of them.
+	//
+	struct FrameCommand
+	{
+		FrameCommandType	m_type = FRAME_DRAW;
+		BlendMode			m_blendMode = BlendMode::ALPHA;
+		Rgba8				m_clearColor;
+		Texture const*		m_texture = nullptr;
+		int					m_cameraIndex = -1;
+		int					m_viewportIndex = -1;
+		int					m_firstVert = 0;
+		int					m_numVerts = 0;
+		int					m_firstIndex = 0;
+		int					m_numIndexes = 0;
+	};
+
+	int AddCamera(Camera const& camera);
+
+private:
+	RenderBackend*				m_target = nullptr;
+	std::vector<FrameCommand>	m_commands;
+	std::vector<Camera>			m_cameras;
+	std::vector<ViewportData>	m_viewports;
+	std::vector<Vertex_PCU>		m_verts;
+	std::vector<unsigned int>	m_indexes;
+};
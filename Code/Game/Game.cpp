@@ -10,29 +10,32 @@
 #include "Game/Debris.hpp"
 #include "Game/Beetle.hpp"
 #include "Game/Wasp.hpp"
-#include "Game/Star.hpp"
+#include "Game/Starfield.hpp"
+#include "Game/BatchTransform.hpp"
+#include "Game/SoftwareRasterizer.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Core/VertexUtils.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
-#include "Engine/Renderer/SimpleTriangleFont.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Window/Window.hpp"
+#include <math.h>
 
 extern App* g_theApp;
-extern Renderer* g_theRenderer;
 extern InputSystem* g_theInput;
-extern AudioSystem* g_theAudio;
 extern DevConsole* g_theDevConsole;
 extern EventSystem* g_theEventSystem;
 extern BitmapFont* g_theFont;
 extern Window* g_theWindow;
 
+static_assert(MAX_PLAYERS <= MAX_RENDER_VIEWS, "every player needs its own render view");
+static_assert(MAX_PLAYERS <= MAX_MINIMAP_MARKERS && MAX_PLAYERS <= MAX_MINIMAP_VIEW_FRAMES, "the minimap reserves a marker and a view frame per player");
+
 
 
 Game::Game(App* owner)
@@ -43,8 +46,11 @@ Game::Game(App* owner)
 
 Game::~Game()
 {
-	
-	g_theAudio->StopSound(m_musicPlayback);
+	// the prep thread may still be reading the last snapshot and the mesh library
+	delete m_renderPrepThread;
+	m_renderPrepThread = nullptr;
+
+	g_theAudioThread->StopSound(m_musicPlayback);
 	for (int asIndex = 0; asIndex < MAX_ASTEROIDS; ++asIndex)
 	{
 		delete m_asteroids[asIndex];
@@ -69,257 +75,387 @@ Game::~Game()
 		m_wasps[waspIndex] = nullptr;
 	}
 
-	for (int starIndex = 0; starIndex < MAX_STARS; ++starIndex)
+	for (int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex)
 	{
-		delete m_stars[starIndex];
-		m_stars[starIndex] = nullptr;
+		delete m_playerShips[playerIndex];
+		m_playerShips[playerIndex] = nullptr;
 	}
 
+	delete m_updateGraph;
+	m_updateGraph = nullptr;
 }
 
 void Game::Startup()
 {
 	m_clock = new Clock();
-	m_playerShipA = new PlayerShip(this, Vec2(WORLD_CENTER_X - 50.f, WORLD_CENTER_Y), 0.f, Rgba8(102, 153, 204, 255), false);
-	m_playerShipB = new PlayerShip(this, Vec2(WORLD_CENTER_X + 50.f, WORLD_CENTER_Y), 180.f, Rgba8(153, 0, 0, 255), true);
+	for (int playerIndex = 0; playerIndex < MAX_PLAYERS; ++playerIndex)
+	{
+		m_playerShips[playerIndex] = new PlayerShip(this, playerIndex);
+		m_worldCameraBounds[playerIndex] = AABB2(0.f, 0.f, WORLD_SIZE_X, WORLD_SIZE_Y);
+	}
 	
 	InitializeStartIcon();
-	SpawnRandomBackground();
-	m_start = g_theAudio->CreateOrGetSound("Data/Audio/FirstStart.mp3");
-	m_startPlayback = g_theAudio->StartSound(m_start, false, 0.1f);
+	m_startPlayback = g_theAudioThread->PlayControlledSound(SOUND_FIRST_START, 0.1f, false);
 
 	g_theEventSystem->SubscribeEventCallbackFunction("Keys", Game::Event_KeysAndFuncs);
 	g_theEventSystem->SubscribeEventCallbackFunction("SetTimeScale", Game::Event_SetTimeScale);
+	g_theEventSystem->SubscribeEventCallbackFunction("TaskGraphProfile", Game::Event_TaskGraphProfile);
+	g_theEventSystem->SubscribeEventCallbackFunction("BenchTransform", Game::Event_BenchTransform);
+	g_theEventSystem->SubscribeEventCallbackFunction("SaveFrame", Game::Event_SaveFrame);
+	g_theEventSystem->SubscribeEventCallbackFunction("Quality", Game::Event_Quality);
+	m_qualityGovernor.SetFrameBudgetSeconds(0.001 * static_cast<double>(g_gameConfigBlackboard.GetValue("frameBudgetMs", 16.667f)));
 
 	
 	InitializePortData();
+	BuildUpdateGraph();
+	m_meshLibrary.Startup();
+	m_starfield.Startup(m_meshLibrary, Vec2(WORLD_SIZE_X, WORLD_SIZE_Y));
+	m_renderPrepThread = new RenderPrepThread(m_meshLibrary);
 }
 
 void Game::Update()
 {	
 	HandleInput();
+	ApplyQualitySettings();
 
 	float deltaSeconds = m_clock->GetDeltaSeconds();
 
 	if (!m_isAttractMode)
 	{
-		g_theAudio->StopSound(m_startPlayback);
-		UpdateEntities(deltaSeconds);
-		UpdateWave(deltaSeconds);
-		CheckEnemiesVsShips();
-		CheckBulletsVsEnemies();
-		CheckShipVsShip(*m_playerShipA, *m_playerShipB);
+		g_theAudioThread->StopSound(m_startPlayback);
+		m_startPlayback = INVALID_AUDIO_HANDLE;
+		m_updateDeltaSeconds = deltaSeconds;
+		m_updateGraph->Execute();
+
+		// the sync point stays on this thread: it is the only producer the audio queue allows
+		ApplyCommandBuffers();
 		DeleteGarbages();
 		UpdateMusic(deltaSeconds);
+		PublishRenderSnapshot();
+		UpdateMinimap(deltaSeconds);
 	} 
 	else 
 	{
 		
 		UpdateAttractMode(deltaSeconds);
+		UpdateWorldCameras(deltaSeconds);
 	}
 
-	UpdateACameras(deltaSeconds);
+	UpdateHud();
+}
+
+void Game::BuildUpdateGraph()
+{
+	int numWorkerThreads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+	if (numWorkerThreads < 1)
+	{
+		numWorkerThreads = 1;
+	}
+	else if (numWorkerThreads > MAX_SIM_WORKERS - 1)
+	{
+		numWorkerThreads = MAX_SIM_WORKERS - 1;
+	}
+	m_updateGraph = new TaskGraph(numWorkerThreads);
+
+	// Order of AddTask is the serial order; the declared resources decide what may overlap.
+	// Enemy updates push each other apart, so every enemy list update writes all enemy lists.
+	m_updateGraph->AddTask("UpdateShips", TASK_RESOURCE_NONE, TASK_RESOURCE_SHIPS,
+		[this]() { UpdateShips(m_updateDeltaSeconds); });
+	m_updateGraph->AddTask("UpdateBullets", TASK_RESOURCE_NONE, TASK_RESOURCE_BULLETS,
+		[this]() { UpdateEntityList(MAX_BULLETS, m_bullets, false, m_updateDeltaSeconds); });
+	m_updateGraph->AddTask("UpdateAsteroids", TASK_RESOURCE_NONE, TASK_RESOURCE_ENEMIES,
+		[this]() { UpdateEntityList(MAX_ASTEROIDS, m_asteroids, true, m_updateDeltaSeconds); });
+	m_updateGraph->AddTask("UpdateBeetles", TASK_RESOURCE_SHIPS, TASK_RESOURCE_ENEMIES,
+		[this]() { UpdateEntityList(MAX_BETTLES, m_beetles, true, m_updateDeltaSeconds); });
+	m_updateGraph->AddTask("UpdateWasps", TASK_RESOURCE_SHIPS, TASK_RESOURCE_ENEMIES,
+		[this]() { UpdateEntityList(MAX_WASPS, m_wasps, true, m_updateDeltaSeconds); });
+	m_updateGraph->AddTask("UpdateDebris", TASK_RESOURCE_NONE, TASK_RESOURCE_DEBRIS,
+		[this]() { UpdateEntityList(MAX_DEBRIS, m_debris, false, m_updateDeltaSeconds); });
+	m_updateGraph->AddTask("UpdateWave", TASK_RESOURCE_SHIPS, TASK_RESOURCE_WAVE | TASK_RESOURCE_ENEMIES | TASK_RESOURCE_RNG,
+		[this]() { UpdateWave(m_updateDeltaSeconds); });
+	m_updateGraph->AddTask("CheckEnemiesVsShips", TASK_RESOURCE_NONE, TASK_RESOURCE_SHIPS | TASK_RESOURCE_ENEMIES,
+		[this]() { CheckEnemiesVsShips(); });
+	m_updateGraph->AddTask("CheckBulletsVsEnemies", TASK_RESOURCE_NONE, TASK_RESOURCE_BULLETS | TASK_RESOURCE_ENEMIES | TASK_RESOURCE_ENEMY_GRID,
+		[this]() { CheckBulletsVsEnemies(); });
+	m_updateGraph->AddTask("CheckShipsVsShips", TASK_RESOURCE_NONE, TASK_RESOURCE_SHIPS,
+		[this]() { CheckShipsVsShips(); });
+	m_updateGraph->AddTask("UpdateCameras", TASK_RESOURCE_SHIPS, TASK_RESOURCE_CAMERAS | TASK_RESOURCE_RNG,
+		[this]() { UpdateWorldCameras(m_updateDeltaSeconds); });
+
+	// No task touches g_theAudioThread: sounds go through the command buffers, and Update runs
+	// the sync point (ApplyCommandBuffers, DeleteGarbages) and UpdateMusic after Execute.
+	GUARANTEE_OR_DIE(m_updateGraph->GetNumTasks() < MAX_COMMAND_BUFFERS, "every update task needs its own command buffer");
+}
+
+//-----------------------------------------------------------------------------------------------
+// Double-buffered hand-off to the render prep thread. The list built from the previous
+// snapshot becomes the one Render submits, and this tick's snapshot is prepared while the
+// next tick simulates, so the world is drawn one tick behind the simulation.
+//
+void Game::PublishRenderSnapshot()
+{
+	m_renderPrepThread->WaitUntilIdle();
+	m_readyRenderIndex = 1 - m_readyRenderIndex;
+
+	m_readySnapshotVersion = m_prepSnapshotVersion;
 
-	if (m_multiplayer)
+	int prepIndex = 1 - m_readyRenderIndex;
+	ExtractRenderSnapshot(m_renderSnapshots[prepIndex]);
+	if (!m_renderSnapshots[prepIndex].IsSameFrameAs(m_renderSnapshots[m_readyRenderIndex]))
 	{
-		UpdateBCameras(deltaSeconds);
+		++m_prepSnapshotVersion;
 	}
-
-	
+	m_renderPrepThread->Kick(&m_renderSnapshots[prepIndex], &m_worldCommandLists[prepIndex][0]);
 }
 
+//-----------------------------------------------------------------------------------------------
+// Frames likely to repeat are recorded as they are drawn. While the frame key still matches the
+// recording nothing is rebuilt: the recording is replayed, or not even that when the backend
+// still holds the image. The dev console is always drawn live on top.
+//
 void Game::Render() const
 {
-	g_theRenderer->ClearScreen(Rgba8(0, 0, 0, 255));
-	
-	if (!m_isAttractMode)
+	IdleFrameKey frameKey = GetIdleFrameKey();
+	if (m_hasRecordedFrame && frameKey == m_recordedFrameKey)
 	{
-		if (m_clock->IsPaused())
-		{
-			g_theRenderer->SetBlendMode(BlendMode::ALPHA);
-		}
-		else
+		if (!g_theRenderBackend->KeepsLastFrame())
 		{
-			g_theRenderer->SetBlendMode(BlendMode::ADDITIVE);
+			m_frameRecorder.Replay(*g_theRenderBackend);
 		}
-		RenderGame();
+	}
+	else if (ShouldRecordFrame())
+	{
+		// everything RenderFrame draws goes through g_theRenderBackend, so the recorder sits in for it
+		RenderBackend* liveBackend = g_theRenderBackend;
+		m_frameRecorder.BeginRecording(liveBackend);
+		g_theRenderBackend = &m_frameRecorder;
+		RenderFrame();
+		g_theRenderBackend = liveBackend;
+		m_frameRecorder.EndRecording();
+		m_recordedFrameKey = frameKey;
+		m_hasRecordedFrame = true;
 	}
 	else
 	{
-		RenderAttractMode();
+		RenderFrame();
+		m_hasRecordedFrame = false;
 	}
 	
 	RenderDevConsole();
 }
 
-void Game::RenderDevConsole() const
+FramePacingMode Game::GetFramePacingMode() const
 {
-	g_theRenderer->BeginCamera(m_screenCamera);
-
-	if (g_theDevConsole)
+	if (m_isAttractMode)
 	{
-		g_theDevConsole->Render(AABB2(0, 0, 1600, 800));
+		return FRAME_PACING_ATTRACT;
 	}
-
-	g_theRenderer->EndCamera(m_screenCamera);
+	return m_clock->IsPaused() ? FRAME_PACING_PAUSED : FRAME_PACING_GAMEPLAY;
 }
 
-void Game::RenderGame() const
+void Game::RenderFrame() const
 {
-	if (!m_multiplayer)
+	g_theRenderBackend->ClearScreen(Rgba8(0, 0, 0, 255));
+	
+	if (!m_isAttractMode)
 	{
-		g_theRenderer->SetViewport(m_fullport);
-		g_theRenderer->BeginCamera(m_worldCameraA);
-		RenderEntities();
-		DebugRender();
-		g_theRenderer->EndCamera(m_worldCameraA);
+		RenderGame();
 	}
 	else
 	{
-
-		g_theRenderer->SetViewport(m_leftport);
-		g_theRenderer->BeginCamera(m_worldCameraA);
-		RenderEntities();
-		DebugRender();
-		g_theRenderer->EndCamera(m_worldCameraA);
-
-		g_theRenderer->SetViewport(m_rightport);
-		g_theRenderer->BeginCamera(m_worldCameraB);
-		RenderEntities();
-		DebugRender();
-		g_theRenderer->EndCamera(m_worldCameraB);
+		RenderAttractMode();
 	}
-
-	g_theRenderer->SetViewport(m_fullport);
-	g_theRenderer->BeginCamera(m_screenCamera);
-	RenderUI();
-	g_theRenderer->EndCamera(m_screenCamera);
-
 }
 
-void Game::RenderUI() const
+IdleFrameKey Game::GetIdleFrameKey() const
 {
-	RenderHealth();
-	RenderTutorialUI();
+	IdleFrameKey frameKey;
+	frameKey.m_isAttractMode = m_isAttractMode;
+	frameKey.m_isDebugActive = m_isDebugActive;
+	frameKey.m_numPlayers = m_numPlayers;
+	frameKey.m_qualityLevel = m_qualityGovernor.GetLevel();
+	frameKey.m_snapshotVersion = m_readySnapshotVersion;
+	frameKey.m_hudVersion = m_hud.GetVersion();
+	frameKey.m_minimapVersion = m_minimap.GetVersion();
+	frameKey.m_movePeriod = m_movePeriod;
+	frameKey.m_blinkPeriod = m_blinkPeriod;
+	return frameKey;
 }
 
+//-----------------------------------------------------------------------------------------------
+// The attract screen repeats between animation steps and a paused game until something changes.
+//
+bool Game::ShouldRecordFrame() const
+{
+	return m_isAttractMode || m_clock->IsPaused();
+}
 
-void Game::PlayMusic()
+bool IdleFrameKey::operator==(IdleFrameKey const& other) const
 {
-	m_music = g_theAudio->CreateOrGetSound("Data/Audio/BuMianZhiYe.mp3");
-	m_musicPlayback = g_theAudio->StartSound(m_music, true, 0.01f);
+	return m_isAttractMode == other.m_isAttractMode && m_isDebugActive == other.m_isDebugActive && m_numPlayers == other.m_numPlayers && m_qualityLevel == other.m_qualityLevel &&
+		   m_snapshotVersion == other.m_snapshotVersion && m_hudVersion == other.m_hudVersion && m_minimapVersion == other.m_minimapVersion &&
+		   m_movePeriod == other.m_movePeriod && m_blinkPeriod == other.m_blinkPeriod;
 }
 
-void Game::UpdateACameras(float deltaSeconds)
+void Game::RenderDevConsole() const
 {
-	if (deltaSeconds == 0.f)
+	g_theRenderBackend->BeginCamera(m_screenCamera);
+
+	// the console draws straight through the engine renderer, which the software renderer never starts
+	if (g_theDevConsole && g_theRenderer)
 	{
-		return;
+		g_theDevConsole->Render(AABB2(0, 0, 1600, 800));
 	}
 
-	m_screenCamera.SetOrthographicView(Vec2(0, 0), Vec2(1600, 800));
+	g_theRenderBackend->EndCamera(m_screenCamera);
+}
 
-	float xOffset;
-	float yOffset;
-	if (!m_multiplayer)
-	{
-		xOffset = 120.f;
-		yOffset = 60.f;
-	}
-	else
+void Game::RenderGame() const
+{
+	RenderSnapshot const& snapshot = m_renderSnapshots[m_readyRenderIndex];
+	RenderCommandList const* worldCommandLists = &m_worldCommandLists[m_readyRenderIndex][0];
+
+	for (int viewIndex = 0; viewIndex < snapshot.m_numViews; ++viewIndex)
 	{
-		xOffset = 60.f;
-		yOffset = 60.f;
+		ViewportData viewport = GetPlayerViewport(viewIndex, snapshot.m_numViews);
+		g_theRenderBackend->SetViewport(viewport);
+		g_theRenderBackend->BeginCamera(snapshot.m_worldCameras[viewIndex]);
+		m_starfield.Render(snapshot.m_viewBounds[viewIndex], snapshot.m_gameSeconds);
+		worldCommandLists[viewIndex].Submit();
+		DebugRender(snapshot, viewIndex, viewport.Width);
+		g_theRenderBackend->EndCamera(snapshot.m_worldCameras[viewIndex]);
 	}
 
-	m_worldCamShakeTraumaA -= CAM_SHAKE_REDUCTION_PER_SECOND * deltaSeconds;
-	m_worldCamShakeTraumaA = GetClampedZeroToOne(m_worldCamShakeTraumaA);
-	
-	Vec2 worldCamMinsA(m_playerShipA->GetPosition().x - xOffset, m_playerShipA->GetPosition().y - yOffset);
-	Vec2 worldCamMaxsA(m_playerShipA->GetPosition().x + xOffset, m_playerShipA->GetPosition().y + yOffset);
+	g_theRenderBackend->SetViewport(m_fullport);
+	g_theRenderBackend->BeginCamera(m_screenCamera);
+	g_theRenderBackend->SetBlendMode(BlendMode::ALPHA);
+	RenderUI();
+	g_theRenderBackend->EndCamera(m_screenCamera);
 
-	if (worldCamMinsA.x < 0.f)
-	{
-		worldCamMinsA.x = 0.f;
-		worldCamMaxsA.x = xOffset * 2;
-	}
-	else if (worldCamMaxsA.x > WORLD_SIZE_X)
-	{
-		worldCamMinsA.x = WORLD_SIZE_X - (xOffset * 2);
-		worldCamMaxsA.x = WORLD_SIZE_X;
-	}
+}
 
-	if (worldCamMinsA.y < 0.f)
+//-----------------------------------------------------------------------------------------------
+// Screen-space (1600x800) region owned by a player: the whole screen alone, left/right halves
+// for two players, quarters for three or four with players 0 and 1 along the top.
+//
+AABB2 Game::GetPlayerScreenBounds(int playerIndex, int numPlayers) const
+{
+	if (numPlayers <= 1)
 	{
-		worldCamMinsA.y = 0.f;
-		worldCamMaxsA.y = yOffset * 2;
+		return AABB2(0.f, 0.f, SCREEN_SIZE_X, SCREEN_SIZE_Y);
 	}
-	else if (worldCamMaxsA.y > WORLD_SIZE_Y)
+
+	float halfWidth = SCREEN_SIZE_X * 0.5f;
+	float halfHeight = SCREEN_SIZE_Y * 0.5f;
+	if (numPlayers == 2)
 	{
-		worldCamMinsA.y = WORLD_SIZE_Y - (yOffset * 2);
-		worldCamMaxsA.y = WORLD_SIZE_Y;
+		float minX = halfWidth * static_cast<float>(playerIndex);
+		return AABB2(minX, 0.f, minX + halfWidth, SCREEN_SIZE_Y);
 	}
 
-	float camShakeAmountA = m_worldCamShakeTraumaA * CAM_SHAKE_MAX;
-	float worldCamShakeXA = m_rng->RollRandomFloatInRange(-camShakeAmountA, camShakeAmountA);
-	float worldCamShakeYA = m_rng->RollRandomFloatInRange(-camShakeAmountA, camShakeAmountA);
-	Vec2 worldCamShakeA(worldCamShakeXA, worldCamShakeYA);
-	worldCamMinsA += worldCamShakeA;
-	worldCamMaxsA += worldCamShakeA;
-	m_worldCameraA.SetOrthographicView(worldCamMinsA, worldCamMaxsA);
+	float minX = halfWidth * static_cast<float>(playerIndex % 2);
+	float minY = halfHeight * static_cast<float>(1 - playerIndex / 2);
+	return AABB2(minX, minY, minX + halfWidth, minY + halfHeight);
+}
 
+ViewportData Game::GetPlayerViewport(int playerIndex, int numPlayers) const
+{
+	AABB2 screenBounds = GetPlayerScreenBounds(playerIndex, numPlayers);
+	float scaleX = m_fullport.Width / SCREEN_SIZE_X;
+	float scaleY = m_fullport.Height / SCREEN_SIZE_Y;
+
+	ViewportData viewport = m_fullport;
+	viewport.TopLeftX = screenBounds.m_mins.x * scaleX;
+	viewport.TopLeftY = (SCREEN_SIZE_Y - screenBounds.m_maxs.y) * scaleY;
+	viewport.Width = (screenBounds.m_maxs.x - screenBounds.m_mins.x) * scaleX;
+	viewport.Height = (screenBounds.m_maxs.y - screenBounds.m_mins.y) * scaleY;
+	return viewport;
+}
 
-	
+void Game::RenderUI() const
+{
+	m_minimap.Render();
+	m_hud.Render();
 }
 
-void Game::UpdateBCameras(float deltaSeconds)
+
+void Game::PlayMusic()
+{
+	m_musicVolume = 0.01f;
+	m_musicPlayback = g_theAudioThread->PlayControlledSound(SOUND_MUSIC, m_musicVolume, true);
+}
+
+void Game::UpdateWorldCameras(float deltaSeconds)
 {
 	if (deltaSeconds == 0.f)
 	{
 		return;
 	}
 
-	float xOffset = 60.f;
-	float yOffset = 60.f;
+	m_screenCamera.SetOrthographicView(Vec2(0, 0), Vec2(1600, 800));
 
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+	{
+		UpdateWorldCamera(playerIndex, deltaSeconds);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Every camera keeps the single-player zoom: its world extents shrink with its share of the
+// screen, 240x120 alone, 120x120 for a half and 120x60 for a quarter.
+//
+void Game::UpdateWorldCamera(int playerIndex, float deltaSeconds)
+{
+	float xOffset = 120.f;
+	float yOffset = 60.f;
+	if (m_numPlayers == 2)
+	{
+		xOffset = 60.f;
+	}
+	else if (m_numPlayers > 2)
+	{
+		xOffset = 60.f;
+		yOffset = 30.f;
+	}
 
-	m_worldCamShakeTraumaB -= CAM_SHAKE_REDUCTION_PER_SECOND * deltaSeconds;
-	m_worldCamShakeTraumaB = GetClampedZeroToOne(m_worldCamShakeTraumaB);
+	float& trauma = m_worldCamShakeTraumas[playerIndex];
+	trauma -= CAM_SHAKE_REDUCTION_PER_SECOND * deltaSeconds;
+	trauma = GetClampedZeroToOne(trauma);
 
-	Vec2 worldCamMinsB(m_playerShipB->GetPosition().x - xOffset, m_playerShipB->GetPosition().y - yOffset);
-	Vec2 worldCamMaxsB(m_playerShipB->GetPosition().x + xOffset, m_playerShipB->GetPosition().y + yOffset);
+	Vec2 shipPosition = m_playerShips[playerIndex]->GetPosition();
+	Vec2 worldCamMins(shipPosition.x - xOffset, shipPosition.y - yOffset);
+	Vec2 worldCamMaxs(shipPosition.x + xOffset, shipPosition.y + yOffset);
 
-	if (worldCamMinsB.x < 0.f)
+	if (worldCamMins.x < 0.f)
 	{
-		worldCamMinsB.x = 0.f;
-		worldCamMaxsB.x = xOffset * 2;
+		worldCamMins.x = 0.f;
+		worldCamMaxs.x = xOffset * 2;
 	}
-	else if (worldCamMaxsB.x > WORLD_SIZE_X)
+	else if (worldCamMaxs.x > WORLD_SIZE_X)
 	{
-		worldCamMinsB.x = WORLD_SIZE_X - xOffset * 2;
-		worldCamMaxsB.x = WORLD_SIZE_X;
+		worldCamMins.x = WORLD_SIZE_X - (xOffset * 2);
+		worldCamMaxs.x = WORLD_SIZE_X;
 	}
 
-	if (worldCamMinsB.y < 0.f)
+	if (worldCamMins.y < 0.f)
 	{
-		worldCamMinsB.y = 0.f;
-		worldCamMaxsB.y = yOffset * 2;
+		worldCamMins.y = 0.f;
+		worldCamMaxs.y = yOffset * 2;
 	}
-	else if (worldCamMaxsB.y > WORLD_SIZE_Y)
+	else if (worldCamMaxs.y > WORLD_SIZE_Y)
 	{
-		worldCamMinsB.y = WORLD_SIZE_Y - (yOffset * 2);
-		worldCamMaxsB.y = WORLD_SIZE_Y;
+		worldCamMins.y = WORLD_SIZE_Y - (yOffset * 2);
+		worldCamMaxs.y = WORLD_SIZE_Y;
 	}
 
-	float camShakeAmountB = m_worldCamShakeTraumaB * CAM_SHAKE_MAX;
-	float worldCamShakeXB = m_rng->RollRandomFloatInRange(-camShakeAmountB, camShakeAmountB);
-	float worldCamShakeYB = m_rng->RollRandomFloatInRange(-camShakeAmountB, camShakeAmountB);
-	Vec2 worldCamShakeB(worldCamShakeXB, worldCamShakeYB);
-	worldCamMinsB += worldCamShakeB;
-	worldCamMaxsB += worldCamShakeB;
-
-
-	m_worldCameraB.SetOrthographicView(worldCamMinsB, worldCamMaxsB);
+	float camShakeAmount = trauma * CAM_SHAKE_MAX;
+	float worldCamShakeX = m_rng->RollRandomFloatInRange(-camShakeAmount, camShakeAmount);
+	float worldCamShakeY = m_rng->RollRandomFloatInRange(-camShakeAmount, camShakeAmount);
+	Vec2 worldCamShake(worldCamShakeX, worldCamShakeY);
+	worldCamMins += worldCamShake;
+	worldCamMaxs += worldCamShake;
+	m_worldCameras[playerIndex].SetOrthographicView(worldCamMins, worldCamMaxs);
+	m_worldCameraBounds[playerIndex] = AABB2(worldCamMins, worldCamMaxs);
 }
 
 void Game::UpdateMusic(float deltaSeconds)
@@ -331,25 +467,27 @@ void Game::UpdateMusic(float deltaSeconds)
 		PlayMusic();
 	}
 
-	if (m_muteMusic)
+	// only changes go through the audio queue
+	float musicVolume = m_muteMusic ? 0.f : 0.01f;
+	if (musicVolume != m_musicVolume)
 	{
-		g_theAudio->SetSoundPlaybackVolume(m_musicPlayback, 0.0f);
-	}
-	else
-	{
-		g_theAudio->SetSoundPlaybackVolume(m_musicPlayback, 0.01f);
+		m_musicVolume = musicVolume;
+		g_theAudioThread->SetSoundVolume(m_musicPlayback, musicVolume);
 	}
 }
 
-void Game::AddCameraShakeTrauma(float shake, bool isPlayerB)
+void Game::AddCameraShakeTrauma(float shake, int playerIndex)
 {
-	if (!isPlayerB)
+	if (playerIndex == ALL_PLAYERS)
 	{
-		m_worldCamShakeTraumaA += shake;
+		for (int shakeIndex = 0; shakeIndex < MAX_PLAYERS; ++shakeIndex)
+		{
+			m_worldCamShakeTraumas[shakeIndex] += shake;
+		}
 	}
 	else
 	{
-		m_worldCamShakeTraumaB += shake;
+		m_worldCamShakeTraumas[playerIndex] += shake;
 	}
 }
 
@@ -402,9 +540,22 @@ bool Game::IsAlive(Entity* entity) const
 	return true;
 }
 
+//-----------------------------------------------------------------------------------------------
+// The animation advances in fixed steps so the screen holds still between them, and the frames
+// in between are replays.
+//
 void Game::UpdateAttractMode(float deltaSeconds)
 {
+	m_attractStepSeconds += deltaSeconds;
+	while (m_attractStepSeconds >= ATTRACT_ANIMATION_STEP_SECONDS)
+	{
+		m_attractStepSeconds -= ATTRACT_ANIMATION_STEP_SECONDS;
+		StepAttractAnimation(ATTRACT_ANIMATION_STEP_SECONDS);
+	}
+}
 
+void Game::StepAttractAnimation(float deltaSeconds)
+{
 	if (!m_startAlphaUp && m_blinkPeriod < 0.5f)
 	{
 		m_blinkPeriod += deltaSeconds;
@@ -436,12 +587,21 @@ void Game::UpdateAttractMode(float deltaSeconds)
 
 void Game::RenderAttractMode() const
 {
-	g_theRenderer->BeginCamera(m_screenCamera);
-	RenderFakeShip(80.f, 0.f, Vec2(400.f + m_movePeriod * 40.f, 400.f), Rgba8(102, 153, 204, 255));
-
-	if (m_multiplayer)
+	g_theRenderBackend->BeginCamera(m_screenCamera);
+	g_theRenderBackend->SetBlendMode(BlendMode::ALPHA);
+	float moveOffset = m_movePeriod * 40.f;
+	Vec2 const fakeShipPositions[MAX_PLAYERS] =
+	{
+		Vec2(400.f + moveOffset, 400.f),
+		Vec2(1200.f - moveOffset, 400.f),
+		Vec2(800.f, 270.f + moveOffset * 0.5f),
+		Vec2(800.f, 640.f - moveOffset * 0.5f),
+	};
+	float fakeShipScale = m_numPlayers > 2 ? 50.f : 80.f;
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
 	{
-		RenderFakeShip(80.f, 180.f, Vec2(1200.f - m_movePeriod * 40.f, 400.f), Rgba8(153, 0, 0, 255));
+		RenderFakeShip(fakeShipScale, PlayerShip::GetStartOrientationDegrees(playerIndex), fakeShipPositions[playerIndex], 
+					   PlayerShip::GetPlayerColor(playerIndex));
 	}
 
 	Vertex_PCU startSpaceVerts[NUM_WASP_VERTS];
@@ -456,109 +616,31 @@ void Game::RenderAttractMode() const
 		startSpaceVerts[vertIndex].m_color = colorNow;
 	}
 	TransformVertexArrayXY3D(NUM_WASP_VERTS, &startSpaceVerts[0], 50.f, 0.f, Vec2(800.f, 400.f));
-	g_theRenderer->DrawVertexArray(NUM_WASP_VERTS, &startSpaceVerts[0]);
+	g_theRenderBackend->DrawVertexArray(NUM_WASP_VERTS, &startSpaceVerts[0]);
 	
-	std::vector<Vertex_PCU> textVerts;
-	AddVertsForTextTriangles2D(textVerts, "Press [SPACE] to Start", Vec2(630.f, 80.f), 30.f, Rgba8(255,255,255, 
-							   static_cast<unsigned char> (RangeMapClamped(m_blinkPeriod, 0.f, 0.5f, 200.f, 100.f))), .4f);
-	if (!m_multiplayer)
-	{
-		AddVertsForTextTriangles2D(textVerts, "Press [M] for Multiplayer", Vec2(610.f, 150.f), 30.f, Rgba8(255, 255, 255, 
-								   static_cast<unsigned char> (RangeMapClamped(m_blinkPeriod, 0.f, 0.5f, 200.f, 100.f))), .4f);
-	}
-	else
-	{
-		AddVertsForTextTriangles2D(textVerts, "Press [M] for Singleplayer", Vec2(610.f, 150.f), 30.f, Rgba8(255, 255, 255, 
-								   static_cast<unsigned char> (RangeMapClamped(m_blinkPeriod, 0.f, 0.5f, 200.f, 100.f))), .4f);
-	}
-	g_theRenderer->DrawVertexArray(static_cast<int>(textVerts.size()), textVerts.data());
-	g_theRenderer->EndCamera(m_screenCamera);
+	m_hud.Render();
+	g_theRenderBackend->EndCamera(m_screenCamera);
 }
 
 void Game::Shutdown()
 {
-	g_theAudio->StopSound(m_musicPlayback);
+	g_theAudioThread->StopSound(m_musicPlayback);
 }
 
-void Game::DebugRender() const
+//-----------------------------------------------------------------------------------------------
+// Draws the F1 shapes recorded with the snapshot, so they line up with the meshes of that tick.
+// Everything for one view goes into m_debugDraw and is drawn in one call at the end.
+//
+void Game::DebugRender(RenderSnapshot const& snapshot, int viewIndex, float viewportWidthPixels) const
 {
-	if (m_isDebugActive)
+	if (snapshot.m_debugShapes.IsEmpty())
 	{
-		for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; ++bulletIndex)
-		{
-			Bullet const* bullet = dynamic_cast<Bullet*>(m_bullets[bulletIndex]);
-			if (bullet)
-			{
-				bullet->DebugRender();
-				
-
-
-				DebugDrawLine(bullet->GetPosition(), m_playerShipA->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
-				
-				if (m_multiplayer)
-				{
-					DebugDrawLine(bullet->GetPosition(), m_playerShipB->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
-
-				}
-			}
-		}
-
-		for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; ++asteroidIndex)
-		{
-			Asteroid const* asteroid = dynamic_cast<Asteroid*>(m_asteroids[asteroidIndex]);
-			if (asteroid)
-			{
-				asteroid->DebugRender();
-				
-				DebugDrawLine(asteroid->GetPosition(), m_playerShipA->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
-				if (m_multiplayer)
-				{
-					DebugDrawLine(asteroid->GetPosition(), m_playerShipB->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
-				}
-			}
-		}
-
-		for (int beetIndex = 0; beetIndex < MAX_BETTLES; ++beetIndex)
-		{
-			Bettle const* bettle = dynamic_cast<Bettle*>(m_beetles[beetIndex]);
-			if (bettle)
-			{
-
-				bettle->DebugRender();
-				
-
-				DebugDrawLine(bettle->GetPosition(), m_playerShipA->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
-				if (m_multiplayer)
-				{
-					DebugDrawLine(bettle->GetPosition(), m_playerShipB->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
-				}
-
-			}
-		}
-
-		for (int waspIndex = 0; waspIndex < MAX_WASPS; ++waspIndex)
-		{
-			Wasp const* wasp = dynamic_cast<Wasp*>(m_wasps[waspIndex]);
-			if (wasp)
-			{
-				wasp->DebugRender();
-				
-
-				DebugDrawLine(wasp->GetPosition(), m_playerShipA->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
-				if (m_multiplayer)
-				{
-					DebugDrawLine(wasp->GetPosition(), m_playerShipB->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
-				}
-
-			}
-		}
-		m_playerShipA->DebugRender();
-		if (m_multiplayer)
-		{
-			m_playerShipB->DebugRender();
-		}
+		return;
 	}
 
+	m_debugDraw.BeginView(snapshot.m_viewBounds[viewIndex], viewportWidthPixels);
+	snapshot.m_debugShapes.AddTo(m_debugDraw);
+	m_debugDraw.Flush();
 }
 
 void Game::HandleInput()
@@ -600,9 +682,8 @@ void Game::HandleInput()
 		}
 		else
 		{
-			g_theApp->ResetGame();
-			SoundID back = g_theAudio->CreateOrGetSound("Data/Audio/Back.wav");
-			g_theAudio->StartSound(back, false, 0.1f);
+			g_theApp->RequestResetGame();
+			g_theAudioThread->PlaySound(SOUND_BACK, 0.1f);
 		}
 
 	}
@@ -611,9 +692,8 @@ void Game::HandleInput()
 	{
 		if (g_theInput->WasKeyJustPressed('M'))
 		{
-			m_multiplayer = !m_multiplayer;
-			SoundID multiplayer = g_theAudio->CreateOrGetSound("Data/Audio/Multiplayer.wav");
-			g_theAudio->StartSound(multiplayer, false, 0.1f);
+			m_numPlayers = m_numPlayers % MAX_PLAYERS + 1;
+			g_theAudioThread->PlaySound(SOUND_MULTIPLAYER, 0.1f);
 		}
 
 		if (g_theInput->WasKeyJustPressed(' ') ||
@@ -628,7 +708,7 @@ void Game::HandleInput()
 
 	if (g_theInput->WasKeyJustPressed(KEYCODE_F8))
 	{
-		g_theApp->ResetGame();
+		g_theApp->RequestResetGame();
 	}
 
 	if (g_theInput->WasKeyJustPressed('Q'))
@@ -788,9 +868,9 @@ void Game::SpawnBullets(Vec2 const& position, float orientationDegrees, Vec2 vel
 	}
 }
 
-void Game::SpawnNewDebris(Vec2 const& position, Vec2 const& velocity, float radius, Rgba8 const& color)
+void Game::SpawnNewDebris(Vec2 const& position, Vec2 const& velocity, float radius, Rgba8 const& color, DebrisRolls const& rolls)
 {
-	Debris* m_deb = new Debris(this, position, velocity, radius, color);
+	Debris* m_deb = new Debris(this, position, velocity, radius, color, rolls);
 	for (int i = 0; i < MAX_DEBRIS; ++i)
 	{
 		if (m_debris[i] == nullptr)
@@ -803,28 +883,57 @@ void Game::SpawnNewDebris(Vec2 const& position, Vec2 const& velocity, float radi
 	
 }
 
+//-----------------------------------------------------------------------------------------------
+// The quality governor may thin the cluster out, but every piece still takes all of its rolls
+// (scatter here, spin, drift and mesh in Debris::RollDebris) from the shared RNG, so enemy spawns
+// and camera shake see the same random stream at every quality level.
+//
 void Game::SpawnNewDebrisCluster(int numDebris, Vec2 const& position, Vec2 const& averageVelocity, float spraySpeed, float radius, Rgba8 const& color)
 {
+	int numSpawned = static_cast<int>(ceilf(static_cast<float>(numDebris) * m_qualityGovernor.GetSettings().m_debrisFraction));
 	for (int i = 0; i < numDebris; ++i)
 	{
 		float thetaDegrees = m_rng->RollRandomFloatInRange(0.f, 360.f);
 		float speed = m_rng->RollRandomFloatInRange(1.f, spraySpeed);
+		DebrisRolls rolls = Debris::RollDebris(m_rng);
+		if (i >= numSpawned)
+		{
+			continue;
+		}
 		Vec2 scatterVelocity = Vec2::MakeFromPolarDegrees(thetaDegrees, speed);
 		Vec2 velocity = averageVelocity + scatterVelocity;
-		SpawnNewDebris(position, velocity, radius, color);
+		SpawnNewDebris(position, velocity, radius, color, rolls);
 	}
 }
 
 PlayerShip* Game::GetPlayership(int shipIndex) const
 {
-	if (shipIndex == 0)
-	{
-		return m_playerShipA;
-	}
-	else
+	return m_playerShips[shipIndex];
+}
+
+//-----------------------------------------------------------------------------------------------
+// Enemies chase the closest ship that is in play and not cloaked; nullptr when there is none.
+//
+PlayerShip* Game::FindNearestTargetableShip(Vec2 const& position) const
+{
+	PlayerShip* nearestShip = nullptr;
+	float nearestDistanceSquared = 0.f;
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
 	{
-		return m_playerShipB;
+		PlayerShip* ship = m_playerShips[playerIndex];
+		if (!ship->IsAlive() || ship->m_isInvisible)
+		{
+			continue;
+		}
+
+		float distanceSquared = GetDistanceSquared2D(position, ship->GetPosition());
+		if (nearestShip == nullptr || distanceSquared < nearestDistanceSquared)
+		{
+			nearestShip = ship;
+			nearestDistanceSquared = distanceSquared;
+		}
 	}
+	return nearestShip;
 }
 
 bool Game::Event_KeysAndFuncs(EventArgs& args)
@@ -846,6 +955,8 @@ bool Game::Event_KeysAndFuncs(EventArgs& args)
 	g_theDevConsole->AddLine(gameColor, "	[I]	     - Spawn 1 Asteroid");
 	g_theDevConsole->AddLine(gameColor, "	[F1]     - Debug Draw");
 	g_theDevConsole->AddLine(gameColor, "	[F8]     - Reset Game");
+	g_theDevConsole->AddLine(gameColor, "TaskGraphProfile - Print last update task timings and critical path");
+	g_theDevConsole->AddLine(gameColor, "BenchTransform instances=10000 - Time scalar vs batched instance transforms per mesh");
 	
 	return true;
 }
@@ -866,136 +977,389 @@ bool Game::Event_SetTimeScale(EventArgs& args)
 	return true;
 }
 
+bool Game::Event_TaskGraphProfile(EventArgs& args)
+{
+	UNUSED(args);
+	std::string report = g_theApp->m_game->m_updateGraph->GetLastProfileReport();
+
+	size_t lineStart = 0;
+	while (lineStart < report.size())
+	{
+		size_t lineEnd = report.find('\n', lineStart);
+		if (lineEnd == std::string::npos)
+		{
+			lineEnd = report.size();
+		}
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, report.substr(lineStart, lineEnd - lineStart));
+		lineStart = lineEnd + 1;
+	}
+
+	RenderPrepThread const* renderPrepThread = g_theApp->m_game->m_renderPrepThread;
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("RenderPrep (overlapped): %.3f ms", renderPrepThread->GetLastPrepSeconds() * 1000.0));
 
+	Game const* game = g_theApp->m_game;
+	RenderSnapshot const& snapshot = game->m_renderSnapshots[game->m_readyRenderIndex];
+	for (int viewIndex = 0; viewIndex < snapshot.m_numViews; ++viewIndex)
+	{
+		RenderCommandList const& commandList = game->m_worldCommandLists[game->m_readyRenderIndex][viewIndex];
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("View %d: %d of %d extracted proxies after culling, %d draws, %d state changes", viewIndex, 
+								 commandList.GetNumInstances(), static_cast<int>(snapshot.m_proxies.size()), commandList.GetNumDraws(), commandList.GetNumStateChanges()));
+	}
+	return true;
+}
 
-void Game::RenderHealth() const
+//-----------------------------------------------------------------------------------------------
+// Microbenchmark for TransformInstances: expands the same random instances of each mesh with the
+// scalar ExpandInstance loop and with the batched kernel, and reports the best of a few runs.
+//
+bool Game::Event_BenchTransform(EventArgs& args)
 {
-	float interval = 50.0f;
+	int numInstances = args.GetValue("instances", 10000);
+	if (numInstances <= 0)
+	{
+		g_theDevConsole->AddLine(DevConsole::ERROR_COLOR, "Error: instances must be positive!");
+		g_theDevConsole->AddLine(DevConsole::WARNING, "Usage: BenchTransform instances=10000");
+		return false;
+	}
+
+	constexpr int NUM_RUNS = 5;
+	MeshLibrary const& meshLibrary = g_theApp->m_game->m_meshLibrary;
+	RandomNumberGenerator benchRng(MESH_VARIANT_SEED);
 
-	for (int healthAIndex = 0; healthAIndex < m_playerShipA->GetExtraLives(); ++healthAIndex)
+	std::vector<RenderInstance> instances(numInstances);
+	for (int instanceIndex = 0; instanceIndex < numInstances; ++instanceIndex)
 	{
-		RenderFakeShip(10.0f, 90.f, Vec2(interval * (healthAIndex + 1), 750.f), Rgba8(102, 153, 204, 255));
+		float degrees = benchRng.RollRandomFloatInRange(0.f, 360.f);
+		RenderInstance& instance = instances[instanceIndex];
+		instance.m_position = Vec2(benchRng.RollRandomFloatInRange(0.f, WORLD_SIZE_X), benchRng.RollRandomFloatInRange(0.f, WORLD_SIZE_Y));
+		instance.m_rotation = Vec2(CosDegrees(degrees), SinDegrees(degrees));
+		instance.m_scale = Vec2(1.f, 1.f);
+		instance.m_tint = Rgba8(255, 255, 255, 255);
 	}
 
-	if (m_multiplayer)
+	g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("BenchTransform: %d instances, best of %d", numInstances, NUM_RUNS));
+	unsigned short const benchMeshIds[] = { MESH_SHIP, MESH_BULLET, MESH_BEETLE, MESH_STAR, MESH_ASTEROID_FIRST, MESH_DEBRIS_FIRST };
+	std::vector<Vertex_PCU> scalarVerts;
+	std::vector<Vertex_PCU> batchVerts;
+	for (unsigned short meshId : benchMeshIds)
 	{
-		for (int healthBIndex = m_playerShipB->GetExtraLives(); healthBIndex > 0; --healthBIndex)
+		Vertex_PCU const* meshVerts = meshLibrary.GetVerts(meshId);
+		int numMeshVerts = meshLibrary.GetNumVerts(meshId);
+		scalarVerts.resize(numInstances * numMeshVerts);
+		batchVerts.resize(numInstances * numMeshVerts);
+
+		double bestScalarSeconds = 0.0;
+		double bestBatchSeconds = 0.0;
+		for (int runIndex = 0; runIndex < NUM_RUNS; ++runIndex)
+		{
+			double startSeconds = GetCurrentTimeSeconds();
+			for (int instanceIndex = 0; instanceIndex < numInstances; ++instanceIndex)
+			{
+				ExpandInstance(meshVerts, numMeshVerts, instances[instanceIndex], &scalarVerts[instanceIndex * numMeshVerts]);
+			}
+			double scalarSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+			startSeconds = GetCurrentTimeSeconds();
+			TransformInstances(meshLibrary.GetLocalXs(meshId), meshLibrary.GetLocalYs(meshId), meshVerts, numMeshVerts, instances.data(), numInstances, batchVerts.data());
+			double batchSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+			if (runIndex == 0 || scalarSeconds < bestScalarSeconds)
+			{
+				bestScalarSeconds = scalarSeconds;
+			}
+			if (runIndex == 0 || batchSeconds < bestBatchSeconds)
+			{
+				bestBatchSeconds = batchSeconds;
+			}
+		}
+
+		float maxError = 0.f;
+		for (int vertIndex = 0; vertIndex < static_cast<int>(scalarVerts.size()); ++vertIndex)
 		{
-			RenderFakeShip(10.0f, 90.f, Vec2(800 + interval * (healthBIndex), 750.f), Rgba8(153, 0, 0, 255));
+			maxError = fmaxf(maxError, fabsf(scalarVerts[vertIndex].m_position.x - batchVerts[vertIndex].m_position.x));
+			maxError = fmaxf(maxError, fabsf(scalarVerts[vertIndex].m_position.y - batchVerts[vertIndex].m_position.y));
 		}
+
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  mesh %2d (%2d verts): scalar %.3f ms, batch %.3f ms, x%.2f, max error %g",
+			meshId, numMeshVerts, bestScalarSeconds * 1000.0, bestBatchSeconds * 1000.0, bestScalarSeconds / fmax(bestBatchSeconds, 1e-9), maxError));
 	}
+	return true;
 }
 
-void Game::RenderTutorialUI() const
+//-----------------------------------------------------------------------------------------------
+// Writes the last finished frame of the software rasterizer to a TGA file.
+//
+bool Game::Event_SaveFrame(EventArgs& args)
 {
-	std::vector<Vertex_PCU> textVerts;
-	AddVertsForTextTriangles2D(textVerts, "[J]					 -> Fire", 
-							   Vec2(35.f, 700.f), 15, Rgba8(255, 255, 255, 200));
-	AddVertsForTextTriangles2D(textVerts, "[K]					 -> Bullet Burst Alpha", 
-							   Vec2(35.f, 680.f), 15, Rgba8(255, 255, 255, 200));
-	AddVertsForTextTriangles2D(textVerts, "[L]					 -> Bullet Burst Beta", 
-							   Vec2(35.f, 660.f), 15, Rgba8(255, 255, 255, 200));
-	AddVertsForTextTriangles2D(textVerts, "[SPACE]		-> Stealthy", 
-							   Vec2(35.f, 640.f), 15, Rgba8(255, 255, 255, 200));
-	
-	AddVertsForTextTriangles2D(textVerts, "[ESC] -> Back to Menu",
-		Vec2(1340, 750), 15, Rgba8(255, 255, 255, 200));
+	SoftwareRasterizer* rasterizer = g_theSoftwareRasterizer;
+	if (rasterizer == nullptr)
+	{
+		g_theDevConsole->AddLine(DevConsole::ERROR_COLOR, "Error: SaveFrame needs softwareRenderer=\"true\" in GameConfig.xml!");
+		return false;
+	}
 
-	if (Clock::GetSystemClock().IsPaused())
+	std::string filePath = args.GetValue("file", "Frame.tga");
+	if (!rasterizer->WriteTGA(filePath.c_str()))
+	{
+		g_theDevConsole->AddLine(DevConsole::ERROR_COLOR, Stringf("Error: could not write %s!", filePath.c_str()));
+		g_theDevConsole->AddLine(DevConsole::WARNING, "Usage: SaveFrame file=Frame.tga");
+		return false;
+	}
+
+	g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("SaveFrame: %s (%dx%d), last frame %d triangles rasterized in %.3f ms",
+		filePath.c_str(), rasterizer->GetWidth(), rasterizer->GetHeight(), rasterizer->GetNumTrianglesLastFlush(), rasterizer->GetLastFlushSeconds() * 1000.0));
+	return true;
+}
+
+
+
+//-----------------------------------------------------------------------------------------------
+// Reports the quality governor's state and history. level=N pins that level; level=-1 hands
+// control back to the governor.
+//
+bool Game::Event_Quality(EventArgs& args)
+{
+	QualityGovernor& governor = g_theApp->m_game->m_qualityGovernor;
+	int forcedLevel = args.GetValue("level", -2);
+	if (forcedLevel >= NUM_QUALITY_LEVELS)
+	{
+		g_theDevConsole->AddLine(DevConsole::ERROR_COLOR, Stringf("Error: level must be below %d!", NUM_QUALITY_LEVELS));
+		g_theDevConsole->AddLine(DevConsole::WARNING, "Usage: Quality level=-1 (automatic) or level=0 (full) to level=4");
+		return false;
+	}
+	if (forcedLevel >= -1)
+	{
+		governor.SetForcedLevel(forcedLevel);
+	}
+
+	QualitySettings const& settings = governor.GetSettings();
+	g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Quality: level %d (%s), smoothed work %.2f ms of a %.2f ms budget",
+		governor.GetLevel(), governor.IsForced() ? "forced" : "automatic", governor.GetSmoothedWorkSeconds() * 1000.0, governor.GetFrameBudgetSeconds() * 1000.0));
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  debris %.0f%%, %d stars per tile, LOD scale %.2f, debug detail %.2f, health bars %s",
+		settings.m_debrisFraction * 100.f, settings.m_starsPerTile, settings.m_lodPixelScale, settings.m_debugDetailScale, settings.m_showHealthBars ? "on" : "off"));
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %d frames, %d over budget; lowered %d times, raised %d times",
+		governor.GetNumFrames(), governor.GetNumFramesOverBudget(), governor.GetNumLowerings(), governor.GetNumRaisings()));
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  last change: %s at frame %d, smoothed work %.2f ms",
+		QualityGovernor::GetReasonName(governor.GetLastChangeReason()), governor.GetLastChangeFrame(), governor.GetLastChangeWorkSeconds() * 1000.0));
+	for (int level = 0; level < NUM_QUALITY_LEVELS; ++level)
+	{
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  level %d held for %.1f s", level, governor.GetSecondsAtLevel(level)));
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Pushes the governor's current level into the render-side knobs that keep their own copy; the
+// snapshot and debris spawning read the settings directly.
+//
+void Game::ApplyQualitySettings()
+{
+	QualitySettings const& settings = m_qualityGovernor.GetSettings();
+	m_starfield.SetNumStarsPerTile(settings.m_starsPerTile);
+	m_debugDraw.SetDetailScale(settings.m_debugDetailScale);
+}
+
+//-----------------------------------------------------------------------------------------------
+// Declares this frame's HUD. Runs after the tick so it sees the final ship and wave state.
+//
+void Game::UpdateHud()
+{
+	m_hud.BeginFrame();
+	if (m_isAttractMode)
 	{
-		AddVertsForTextTriangles2D(textVerts, "[P]			-> Unpause", 
-								   Vec2(1340, 730), 15, Rgba8(255, 255, 255, 200));
+		AddAttractHud();
 	}
 	else
 	{
-		AddVertsForTextTriangles2D(textVerts, "[P]			-> Pause", 
-								   Vec2(1340, 730), 15, Rgba8(255, 255, 255, 200));
+		AddHealthHud();
+		AddTutorialHud();
+	}
+	m_hud.EndFrame();
+}
+
+//-----------------------------------------------------------------------------------------------
+// Reads the enemy grid the last tick built for its collision checks, so the minimap costs no
+// extra pass over the entity lists.
+//
+void Game::UpdateMinimap(float deltaSeconds)
+{
+	if (!m_minimap.IsRefreshDue(deltaSeconds))
+	{
+		return;
+	}
+
+	m_minimap.BeginRefresh(m_enemyGrid);
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+	{
+		Rgba8 playerColor = PlayerShip::GetPlayerColor(playerIndex);
+		m_minimap.AddViewFrame(m_worldCameraBounds[playerIndex], Rgba8(playerColor.r, playerColor.g, playerColor.b, 150));
+
+		PlayerShip* ship = m_playerShips[playerIndex];
+		if (ship->IsAlive())
+		{
+			m_minimap.AddMarker(ship->GetPosition(), playerColor);
+		}
+	}
+}
+
+void Game::AddHealthHud()
+{
+	float interval = 50.0f;
+
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+	{
+		int extraLives = m_playerShips[playerIndex]->GetExtraLives();
+		unsigned int contentKey = static_cast<unsigned int>(extraLives) | (static_cast<unsigned int>(m_numPlayers) << 8);
+		std::vector<Vertex_PCU>* verts = m_hud.AddWidget(HUD_LIVES_FIRST + playerIndex, contentKey);
+		if (verts == nullptr)
+		{
+			continue;
+		}
+
+		AABB2 screenBounds = GetPlayerScreenBounds(playerIndex, m_numPlayers);
+		for (int healthIndex = 0; healthIndex < extraLives; ++healthIndex)
+		{
+			AddVertsForFakeShip(*verts, 10.0f, 90.f, Vec2(screenBounds.m_mins.x + interval * (healthIndex + 1), screenBounds.m_maxs.y - 50.f), 
+								PlayerShip::GetPlayerColor(playerIndex));
+		}
 	}
+}
+
+void Game::AddTutorialHud()
+{
+	Rgba8 const helpColor(255, 255, 255, 200);
+	m_hud.AddText(HUD_KEYBOARD_HELP, "[J]					 -> Fire\n"
+									 "[K]					 -> Bullet Burst Alpha\n"
+									 "[L]					 -> Bullet Burst Beta\n"
+									 "[SPACE]		-> Stealthy", Vec2(35.f, 700.f), 15, helpColor);
 
 	if (Clock::GetSystemClock().IsPaused())
 	{
-		AddVertsForTextTriangles2D(textVerts, "[Q]			-> Unmute Music",
-			Vec2(1340, 710), 15, Rgba8(255, 255, 255, 200));
+		m_hud.AddText(HUD_MENU_HELP, "[ESC] -> Back to Menu\n"
+									 "[P]			-> Unpause\n"
+									 "[Q]			-> Unmute Music", Vec2(1340, 750), 15, helpColor);
 	}
 	else
 	{
-		AddVertsForTextTriangles2D(textVerts, "[Q]			-> Mute Music",
-			Vec2(1340, 710), 15, Rgba8(255, 255, 255, 200));
+		m_hud.AddText(HUD_MENU_HELP, "[ESC] -> Back to Menu\n"
+									 "[P]			-> Pause\n"
+									 "[Q]			-> Mute Music", Vec2(1340, 750), 15, helpColor);
 	}
-	
 
-	
-
-	if (!m_playerShipA->IsAlive())
+	bool isGameOver = m_lose;
+	if (m_numPlayers == 1)
 	{
-		if (!m_multiplayer)
+		if (!m_playerShips[0]->IsAlive())
 		{
-			if (m_playerShipA->GetExtraLives() > 0)
+			if (m_playerShips[0]->GetExtraLives() > 0)
 			{
-				AddVertsForTextTriangles2D(textVerts, "Press [N] to Respwan", 
-										   Vec2(450, 375), 50, Rgba8(255, 255, 255, 200));
+				m_hud.AddText(HUD_RESPAWN_FIRST, "Press [N] to Respwan", Vec2(450, 375), 50, helpColor);
 			}
 			else
 			{
-				AddVertsForTextTriangles2D(textVerts, "Game Over", 
-										   Vec2(500, 350), 100, Rgba8(255, 0, 0, 200));
+				isGameOver = true;
 			}
 		}
-		else
+	}
+	else
+	{
+		std::vector<Vertex_PCU>* dividerVerts = m_hud.AddWidget(HUD_DIVIDERS, static_cast<unsigned int>(m_numPlayers));
+		if (dividerVerts)
 		{
-			if (m_playerShipA->GetExtraLives() > 0)
+			AddVertsForLine2D(*dividerVerts, Vec2(800, 800), Vec2(800, 0), 2.f, Rgba8(255, 255, 255, 100));
+			if (m_numPlayers > 2)
 			{
-				AddVertsForTextTriangles2D(textVerts, "Press [N] to Respwan", 
-										   Vec2(200, 385), 30, Rgba8(255, 255, 255, 200));
+				AddVertsForLine2D(*dividerVerts, Vec2(0, 400), Vec2(1600, 400), 2.f, Rgba8(255, 255, 255, 100));
 			}
 		}
-	}
 
-	if (m_multiplayer)
-	{
+		float respawnTextHeight = m_numPlayers > 2 ? 20.f : 30.f;
+		for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+		{
+			AABB2 screenBounds = GetPlayerScreenBounds(playerIndex, m_numPlayers);
 
-		DebugDrawLine(Vec2(800, 800), Vec2(800, 0), 2.f, Rgba8(255, 255, 255, 100));
+			// Player 0 keeps the keyboard; everyone else is on a controller
+			if (playerIndex > 0)
+			{
+				m_hud.AddText(HUD_CONTROLLER_HELP_FIRST + playerIndex, "[A]		-> Fire\n"
+																	   "[B]		-> Bullet Burst Alpha\n"
+																	   "[X]		-> Bullet Burst Beta\n"
+																	   "[Y]		-> Stealthy",
+							  Vec2(screenBounds.m_mins.x + 35.f, screenBounds.m_maxs.y - 100.f), 15, helpColor);
+			}
 
-		AddVertsForTextTriangles2D(textVerts, "[A]		-> Fire", 
-								   Vec2(835.f, 700.f), 15, Rgba8(255, 255, 255, 200));
-		AddVertsForTextTriangles2D(textVerts, "[B]		-> Bullet Burst Alpha", 
-								   Vec2(835.f, 680.f), 15, Rgba8(255, 255, 255, 200));
-		AddVertsForTextTriangles2D(textVerts, "[X]		-> Bullet Burst Beta", 
-								   Vec2(835.f, 660.f), 15, Rgba8(255, 255, 255, 200));
-		AddVertsForTextTriangles2D(textVerts, "[Y]		-> Stealthy", 
-								   Vec2(835.f, 640.f), 15, Rgba8(255, 255, 255, 200));
-		if (!m_playerShipB->IsAlive() && m_playerShipB->GetExtraLives() > 0)
-		{
-			AddVertsForTextTriangles2D(textVerts, "Press [START] to Respwan", 
-								       Vec2(950.f, 395), 30, Rgba8(255, 255, 255, 200));
+			PlayerShip* ship = m_playerShips[playerIndex];
+			if (!ship->IsAlive() && ship->GetExtraLives() > 0)
+			{
+				Vec2 respawnTextPosition(screenBounds.m_mins.x + 150.f, (screenBounds.m_mins.y + screenBounds.m_maxs.y) * 0.5f - 15.f);
+				m_hud.AddText(HUD_RESPAWN_FIRST + playerIndex, playerIndex == 0 ? "Press [N] to Respwan" : "Press [START] to Respwan", 
+							  respawnTextPosition, respawnTextHeight, helpColor);
+			}
 		}
 	}
 
 	if (m_win)
 	{
-		AddVertsForTextTriangles2D(textVerts, "You Win", Vec2(570, 350), 100, Rgba8(0, 255, 0, 200));
+		m_hud.AddText(HUD_YOU_WIN, "You Win", Vec2(570, 350), 100, Rgba8(0, 255, 0, 200));
 	}
 
-	if (m_lose)
+	if (isGameOver)
 	{
-		AddVertsForTextTriangles2D(textVerts, "Game Over", Vec2(500, 350), 100, Rgba8(255, 0, 0, 200));
+		m_hud.AddText(HUD_GAME_OVER, "Game Over", Vec2(500, 350), 100, Rgba8(255, 0, 0, 200));
 	}
-
-
-
-	g_theRenderer->DrawVertexArray(static_cast<int> (textVerts.size()), textVerts.data());
 }
 
+void Game::AddAttractHud()
+{
+	static char const* const s_playerCountTexts[MAX_PLAYERS] =
+	{
+		"Press [M] for Singleplayer",
+		"Press [M] for 2 Players",
+		"Press [M] for 3 Players",
+		"Press [M] for 4 Players",
+	};
+
+	Rgba8 blinkColor(255, 255, 255, static_cast<unsigned char> (RangeMapClamped(m_blinkPeriod, 0.f, 0.5f, 200.f, 100.f)));
+	m_hud.AddText(HUD_ATTRACT_START, "Press [SPACE] to Start", Vec2(630.f, 80.f), 30.f, blinkColor, .4f);
+	int nextNumPlayers = m_numPlayers % MAX_PLAYERS + 1;
+	m_hud.AddText(HUD_ATTRACT_PLAYERS, s_playerCountTexts[nextNumPlayers - 1], Vec2(610.f, 150.f), 30.f, blinkColor, .4f);
+}
 
 void Game::RenderFakeShip(float scale, float rotationDegrees, Vec2 translation, Rgba8 color) const
 {
+	RenderInstance fakeShip;
+	fakeShip.m_position = translation;
+	fakeShip.m_rotation = Vec2(CosDegrees(rotationDegrees), SinDegrees(rotationDegrees));
+	fakeShip.m_scale = Vec2(scale, scale);
+	fakeShip.m_tint = color;
+
 	Vertex_PCU translucentFakeShip[NUM_SHIP_VERTS];
+	int numShipVerts = m_meshLibrary.GetNumVerts(MESH_SHIP);
+	ExpandInstance(m_meshLibrary.GetVerts(MESH_SHIP), numShipVerts, fakeShip, &translucentFakeShip[0]);
+
+	DrawIndexedVertexArray(numShipVerts, &translucentFakeShip[0], m_meshLibrary.GetNumIndexes(MESH_SHIP), m_meshLibrary.GetIndexes(MESH_SHIP));
+}
 
-	PlayerShip::InitializeVerts(&translucentFakeShip[0], color);
+//-----------------------------------------------------------------------------------------------
+// Same ship as RenderFakeShip, appended to verts as a plain triangle list for the HUD.
+//
+void Game::AddVertsForFakeShip(std::vector<Vertex_PCU>& verts, float scale, float rotationDegrees, Vec2 translation, Rgba8 color) const
+{
+	RenderInstance fakeShip;
+	fakeShip.m_position = translation;
+	fakeShip.m_rotation = Vec2(CosDegrees(rotationDegrees), SinDegrees(rotationDegrees));
+	fakeShip.m_scale = Vec2(scale, scale);
+	fakeShip.m_tint = color;
 
-	TransformVertexArrayXY3D(NUM_SHIP_VERTS, &translucentFakeShip[0], scale, rotationDegrees, translation);
+	Vertex_PCU fakeShipVerts[NUM_SHIP_VERTS];
+	ExpandInstance(m_meshLibrary.GetVerts(MESH_SHIP), m_meshLibrary.GetNumVerts(MESH_SHIP), fakeShip, &fakeShipVerts[0]);
 
-	g_theRenderer->DrawVertexArray(NUM_SHIP_VERTS, &translucentFakeShip[0]);
+	unsigned int const* shipIndexes = m_meshLibrary.GetIndexes(MESH_SHIP);
+	int numShipIndexes = m_meshLibrary.GetNumIndexes(MESH_SHIP);
+	for (int indexIndex = 0; indexIndex < numShipIndexes; ++indexIndex)
+	{
+		verts.push_back(fakeShipVerts[shipIndexes[indexIndex]]);
+	}
 }
 
 void Game::SpawnNewWave()
@@ -1004,7 +1368,7 @@ void Game::SpawnNewWave()
 	int numWasps = m_currentWave * 4;
 	int numAsteroids = m_currentWave * 10 + 20;
 
-	if (m_multiplayer)
+	if (m_numPlayers > 1)
 	{
 		numBeetles *= 2;
 		numWasps *= 2;
@@ -1027,37 +1391,18 @@ void Game::SpawnNewWave()
 
 }
 
-void Game::SpawnRandomBackground()
-{
-	
-	float blinkPeriod = 1.f;
-	Timer* blinkTimer = new Timer(blinkPeriod, m_clock);
-
-
-	for (int i = 0; i < MAX_STARS; ++i)
-	{
-		float randomX = m_rng->RollRandomFloatInRange(0.f, WORLD_SIZE_X);
-		float randomY = m_rng->RollRandomFloatInRange(0.f, WORLD_SIZE_Y);
-
-		Star* star = new Star(this, Vec2(randomX, randomY), 0.f, Rgba8(255, 255, 255, 255));
-		star->m_blinkTimer = blinkTimer;
-		m_stars[i] = star;
-
-	}
-}
-
 void Game::UpdateWave(float deltaSeconds)
 {
 	UNUSED(deltaSeconds);
 	m_win = (m_currentWave > m_maxWaves) && m_waveComplete;
-	if (!m_multiplayer)
+	m_lose = true;
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
 	{
-		m_lose = (!m_playerShipA->IsAlive()) && (m_playerShipA->GetExtraLives() == 0);
-	}
-	else
-	{
-		m_lose = ((!m_playerShipA->IsAlive()) && (m_playerShipA->GetExtraLives() == 0)) &&
-			   ((!m_playerShipB->IsAlive()) && (m_playerShipB->GetExtraLives() == 0));
+		PlayerShip* ship = m_playerShips[playerIndex];
+		if (ship->IsAlive() || ship->GetExtraLives() > 0)
+		{
+			m_lose = false;
+		}
 	}
 
 	HandleGameWinOrLose();
@@ -1075,48 +1420,143 @@ bool Game::DoEntitiesOverlap(Entity const& a, Entity const& b)
 	return DoDiscsOverlap(posA,phyRadA, posB, phyRadB);
 }
 
-void Game::RenderEntities() const
+void Game::ExtractRenderSnapshot(RenderSnapshot& snapshot) const
 {
-	RenderEntityList(MAX_STARS, m_stars);
-	RenderEntityList(MAX_BULLETS, m_bullets);
-	RenderEntityList(MAX_ASTEROIDS, m_asteroids);
-	RenderEntityList(MAX_DEBRIS, m_debris);
-	RenderEntityList(MAX_BETTLES, m_beetles);
-	RenderEntityList(MAX_WASPS, m_wasps);
+	snapshot.Clear();
+	snapshot.m_gameSeconds = m_clock->GetTotalSeconds();
+	snapshot.m_numViews = m_numPlayers;
+	snapshot.m_lodPixelScale = m_qualityGovernor.GetSettings().m_lodPixelScale;
+	snapshot.m_showHealthBars = m_qualityGovernor.GetSettings().m_showHealthBars;
+	for (int viewIndex = 0; viewIndex < m_numPlayers; ++viewIndex)
+	{
+		snapshot.m_worldCameras[viewIndex] = m_worldCameras[viewIndex];
+		snapshot.m_viewBounds[viewIndex] = m_worldCameraBounds[viewIndex];
+		float viewWidth = m_worldCameraBounds[viewIndex].m_maxs.x - m_worldCameraBounds[viewIndex].m_mins.x;
+		snapshot.m_viewPixelsPerUnit[viewIndex] = GetPlayerViewport(viewIndex, m_numPlayers).Width / viewWidth;
+	}
 
-	RenderShip(m_playerShipA);
-	if (m_multiplayer)
+	ExtractEntityList(MAX_BULLETS, m_bullets, snapshot);
+	ExtractEntityList(MAX_ASTEROIDS, m_asteroids, snapshot);
+	ExtractEntityList(MAX_DEBRIS, m_debris, snapshot);
+	ExtractEntityList(MAX_BETTLES, m_beetles, snapshot);
+	ExtractEntityList(MAX_WASPS, m_wasps, snapshot);
+
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
 	{
-		RenderShip(m_playerShipB);
+		ExtractShip(m_playerShips[playerIndex], snapshot);
+	}
+
+	if (m_isDebugActive)
+	{
+		ExtractDebugShapes(snapshot.m_debugShapes);
 	}
-	
 }
 
-void Game::RenderEntityList(int listMaxSize, Entity* const list[]) const
+void Game::ExtractEntityList(int listMaxSize, Entity* const list[], RenderSnapshot& snapshot) const
 {
 	for (int entityIndex = 0; entityIndex < listMaxSize; ++entityIndex)
 	{
 		Entity* entity = list[entityIndex];
-		if (IsAlive(entity))
+		if (!IsAlive(entity))
+		{
+			continue;
+		}
+
+		unsigned char viewMask = snapshot.GetViewMaskForDisc(entity->GetPosition(), entity->GetCosmeticRadius() + RENDER_CULL_PADDING);
+		if (viewMask != 0)
 		{
-			entity->Render();
+			entity->SetViewLods(snapshot.GetViewLodsForDisc(entity->GetCosmeticRadius(), viewMask, entity->GetViewLods()));
+			snapshot.SetCurrentViewMask(viewMask);
+			snapshot.SetCurrentViewLods(entity->GetViewLods());
+			entity->ExtractRenderProxies(snapshot);
 		}
 	}
 }
 
-void Game::RenderShip(PlayerShip* ship) const
+void Game::ExtractShip(PlayerShip* ship, RenderSnapshot& snapshot) const
 {
+	snapshot.SetCurrentViewMask(snapshot.GetAllViewsMask());
+	snapshot.SetCurrentViewLods(0);
 	if (ship->IsAlive())
 	{
-		ship->Render();
+		ship->ExtractRenderProxies(snapshot);
 	}
 	if (ship->m_isInvisible)
 	{
 		Vec2 playerPos = ship->GetPosition();
-		RenderFakeShip(2.f, ship->GetOrientionDegrees(), Vec2(playerPos.x + 4.f, playerPos.y), Rgba8(192, 192, 192, 127));
-		RenderFakeShip(2.f, ship->GetOrientionDegrees(), Vec2(playerPos.x - 4.f, playerPos.y), Rgba8(192, 192, 192, 127));
-		RenderFakeShip(2.f, ship->GetOrientionDegrees(), Vec2(playerPos.x, playerPos.y + 4.f), Rgba8(192, 192, 192, 127));
-		RenderFakeShip(2.f, ship->GetOrientionDegrees(), Vec2(playerPos.x, playerPos.y - 4.f), Rgba8(192, 192, 192, 127));
+		Vec2 const fakeOffsets[4] = { Vec2(4.f, 0.f), Vec2(-4.f, 0.f), Vec2(0.f, 4.f), Vec2(0.f, -4.f) };
+		for (int fakeIndex = 0; fakeIndex < 4; ++fakeIndex)
+		{
+			RenderProxy& fakeShip = snapshot.AddProxy(MESH_SHIP, LAYER_SHIPS, playerPos + fakeOffsets[fakeIndex], ship->GetOrientionDegrees(), Rgba8(192, 192, 192, 127));
+			fakeShip.m_scale = Vec2(2.f, 2.f);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Each entity's rings and axes, plus a line from it to every ship.
+//
+void Game::ExtractDebugShapes(DebugShapeList& debugShapes) const
+{
+	for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; ++bulletIndex)
+	{
+		Bullet const* bullet = dynamic_cast<Bullet*>(m_bullets[bulletIndex]);
+		if (bullet)
+		{
+			bullet->ExtractDebugShapes(debugShapes);
+
+			for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+			{
+				debugShapes.AddLine(bullet->GetPosition(), m_playerShips[playerIndex]->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
+			}
+		}
+	}
+
+	for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; ++asteroidIndex)
+	{
+		Asteroid const* asteroid = dynamic_cast<Asteroid*>(m_asteroids[asteroidIndex]);
+		if (asteroid)
+		{
+			asteroid->ExtractDebugShapes(debugShapes);
+
+			for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+			{
+				debugShapes.AddLine(asteroid->GetPosition(), m_playerShips[playerIndex]->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
+			}
+		}
+	}
+
+	for (int beetIndex = 0; beetIndex < MAX_BETTLES; ++beetIndex)
+	{
+		Bettle const* bettle = dynamic_cast<Bettle*>(m_beetles[beetIndex]);
+		if (bettle)
+		{
+			bettle->ExtractDebugShapes(debugShapes);
+
+			for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+			{
+				debugShapes.AddLine(bettle->GetPosition(), m_playerShips[playerIndex]->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
+			}
+		}
+	}
+
+	for (int waspIndex = 0; waspIndex < MAX_WASPS; ++waspIndex)
+	{
+		Wasp const* wasp = dynamic_cast<Wasp*>(m_wasps[waspIndex]);
+		if (wasp)
+		{
+			wasp->ExtractDebugShapes(debugShapes);
+
+			for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+			{
+				debugShapes.AddLine(wasp->GetPosition(), m_playerShips[playerIndex]->GetPosition(), DEBUG_LINE_THICKNESS, Rgba8(50, 50, 50, 255));
+			}
+		}
+	}
+
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
+	{
+		m_playerShips[playerIndex]->ExtractDebugShapes(debugShapes);
 	}
 }
 
@@ -1129,8 +1569,7 @@ void Game::HandleWaveComplete()
 		m_currentWave += 1;
 		if (m_currentWave <= m_maxWaves)
 		{
-			SoundID newWave = g_theAudio->CreateOrGetSound("Data/Audio/NewWave.wav");
-			g_theAudio->StartSound(newWave, false, 0.3f);
+			GetCommandBuffer().PlaySound(SOUND_NEW_WAVE, 0.3f);
 		}
 	}
 }
@@ -1144,7 +1583,7 @@ void Game::HandleGameOver()
 		if (m_resetTimer >= 3.f)
 		{
 			m_isAttractMode = true;
-			g_theApp->ResetGame();
+			g_theApp->RequestResetGame();
 			
 		}
 		else
@@ -1162,13 +1601,11 @@ void Game::HandleGameWinOrLose()
 
 		if (m_win)
 		{
-			SoundID winSound = g_theAudio->CreateOrGetSound("Data/Audio/win.mp3");
-			g_theAudio->StartSound(winSound, false, 0.5f);
+			GetCommandBuffer().PlaySound(SOUND_WIN, 0.5f);
 		}
 		else if (m_lose)
 		{
-			SoundID loseSound = g_theAudio->CreateOrGetSound("Data/Audio/lose.wav");
-			g_theAudio->StartSound(loseSound, false, 0.5f);
+			GetCommandBuffer().PlaySound(SOUND_LOSE, 0.5f);
 		}
 	}
 }
@@ -1193,6 +1630,47 @@ void Game::CheckWaveEnd()
 	m_waveComplete = true;
 }
 
+void Game::ApplyCommandBuffers()
+{
+	// task order, never worker order: spawns take g_rng rolls and free slots, and sounds coalesce,
+	// so the order has to be the same on every run and every core count
+	for (int bufferIndex = 0; bufferIndex < MAX_COMMAND_BUFFERS; ++bufferIndex)
+	{
+		GameCommandBuffer& commandBuffer = m_commandBuffers[bufferIndex];
+		std::vector<GameCommand> const& commands = commandBuffer.GetCommands();
+		for (int commandIndex = 0; commandIndex < static_cast<int>(commands.size()); ++commandIndex)
+		{
+			ApplyCommand(commands[commandIndex]);
+		}
+		commandBuffer.Clear();
+	}
+}
+
+void Game::ApplyCommand(GameCommand const& command)
+{
+	switch (command.m_type)
+	{
+	case GameCommandType::SPAWN_BULLET:
+		SpawnBullet(command.m_position, command.m_orientationDegrees, command.m_velocity);
+		break;
+	case GameCommandType::SPAWN_BULLET_SPREAD:
+		SpawnBullets(command.m_position, command.m_orientationDegrees, command.m_velocity, command.m_count, command.m_amount);
+		break;
+	case GameCommandType::SPAWN_DEBRIS_CLUSTER:
+		SpawnNewDebrisCluster(command.m_count, command.m_position, command.m_velocity, command.m_amount, command.m_radius, command.m_color);
+		break;
+	case GameCommandType::DESPAWN_ENTITY:
+		command.m_entity->MarkAsGarbage();
+		break;
+	case GameCommandType::PLAY_SOUND:
+		g_theAudioThread->PlaySound(command.m_sound, command.m_amount);
+		break;
+	case GameCommandType::ADD_CAMERA_SHAKE:
+		AddCameraShakeTrauma(command.m_amount, command.m_playerIndex);
+		break;
+	}
+}
+
 void Game::DeleteGarbages()
 {
 	DeleteGarbageList(MAX_BULLETS, m_bullets);
@@ -1224,8 +1702,22 @@ void Game::InitializeStartIcon()
 
 void Game::InitializePortData()
 {
-	float maxX = (float)g_theWindow->GetClientDimensions().x;
-	float maxY = (float)g_theWindow->GetClientDimensions().y;
+	// without a window (software renderer) the viewports cover the rasterizer's frame instead
+	IntVec2 clientDimensions;
+	if (g_theWindow)
+	{
+		clientDimensions = g_theWindow->GetClientDimensions();
+	}
+	else if (g_theSoftwareRasterizer)
+	{
+		clientDimensions = IntVec2(g_theSoftwareRasterizer->GetWidth(), g_theSoftwareRasterizer->GetHeight());
+	}
+	else
+	{
+		ERROR_AND_DIE("Game needs a window or the software rasterizer to size its viewports");
+	}
+	float maxX = (float)clientDimensions.x;
+	float maxY = (float)clientDimensions.y;
 
 
 	m_fullport.TopLeftX = 0.f;
@@ -1234,33 +1726,15 @@ void Game::InitializePortData()
 	m_fullport.Height = maxY;
 
 
-	m_leftport.TopLeftX = 0.f;
-	m_leftport.TopLeftY = 0.f;
-	m_leftport.Width = maxX * 0.5f;
-	m_leftport.Height = maxY;
-
-
-	m_rightport.TopLeftX = maxX * 0.5f;
-	m_rightport.TopLeftY = 0.f;
-	m_rightport.Width = maxX * 0.5f;
-	m_rightport.Height = maxY;
-
 }
 
-void Game::UpdateEntities(float deltaSeconds)
+void Game::UpdateShips(float deltaSeconds)
 {
-	m_playerShipA->Update(deltaSeconds);
-	if (m_multiplayer)
+	for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
 	{
-		m_playerShipB->Update(deltaSeconds);
+		m_playerShips[playerIndex]->RecordLastPosition();
+		m_playerShips[playerIndex]->Update(deltaSeconds);
 	}
-	UpdateEntityList(MAX_STARS, m_stars, false, deltaSeconds);
-	UpdateEntityList(MAX_BULLETS, m_bullets, false, deltaSeconds);
-	UpdateEntityList(MAX_ASTEROIDS, m_asteroids, true, deltaSeconds);
-	UpdateEntityList(MAX_BETTLES, m_beetles, true, deltaSeconds);
-	UpdateEntityList(MAX_WASPS, m_wasps, true, deltaSeconds);
-	UpdateEntityList(MAX_DEBRIS, m_debris, false, deltaSeconds);
-
 }
 
 void Game::UpdateEntityList(int listMaxSize, Entity* list[], bool checkOverlap, float deltaSeconds)
@@ -1271,6 +1745,7 @@ void Game::UpdateEntityList(int listMaxSize, Entity* list[], bool checkOverlap,
 		
 		if (IsAlive(entity))
 		{
+			entity->RecordLastPosition();
 			entity->Update(deltaSeconds);
 
 			if (checkOverlap)
@@ -1288,53 +1763,102 @@ void Game::UpdateEntityList(int listMaxSize, Entity* list[], bool checkOverlap,
 
 }
 
-void Game::CheckBulletsVsEnemies()
+void Game::BuildEnemyGrid()
 {
-	for (int buIndex = 0; buIndex < MAX_BULLETS; ++buIndex)
-	{
-		Bullet* bullet = dynamic_cast<Bullet*> (m_bullets[buIndex]);
-		CheckBulletVsEnemyList(bullet, MAX_ASTEROIDS, m_asteroids);
-		CheckBulletVsEnemyList(bullet, MAX_BETTLES, m_beetles);
-		CheckBulletVsEnemyList(bullet, MAX_WASPS, m_wasps);
-	}
+	m_enemyGrid.Clear();
+	m_enemyGridEntities.clear();
 
+	AddEnemyListToGrid(MAX_ASTEROIDS, m_asteroids);
+	AddEnemyListToGrid(MAX_BETTLES, m_beetles);
+	AddEnemyListToGrid(MAX_WASPS, m_wasps);
+
+	m_enemyGrid.Build();
 }
 
-void Game::CheckBulletVsEnemyList(Bullet* bullet, int listMaxSize, Entity* list[])
+void Game::AddEnemyListToGrid(int listMaxSize, Entity* list[])
 {
 	for (int entityIndex = 0; entityIndex < listMaxSize; ++entityIndex)
 	{
 		Entity* entity = list[entityIndex];
-		if (IsAlive(bullet) && IsAlive(entity))
+		if (IsAlive(entity))
 		{
-			CheckBulletVsEnemy(*bullet, *entity);
+			// bounds cover the whole step so swept tests against this entity are never missed
+			Vec2 start = entity->GetLastPosition();
+			Vec2 end = entity->GetPosition();
+			float radius = entity->GetPhysicsRadius();
+			Vec2 mins(fminf(start.x, end.x) - radius, fminf(start.y, end.y) - radius);
+			Vec2 maxs(fmaxf(start.x, end.x) + radius, fmaxf(start.y, end.y) + radius);
+
+			m_enemyGrid.AddItem(static_cast<int>(m_enemyGridEntities.size()), mins, maxs);
+			m_enemyGridEntities.push_back(entity);
 		}
 	}
 }
 
-void Game::CheckBulletVsEnemy(Bullet& bullet, Entity& entity)
+void Game::CheckBulletsVsEnemies()
 {
-	if (DoEntitiesOverlap(bullet, entity))
+	BuildEnemyGrid();
+
+	for (int buIndex = 0; buIndex < MAX_BULLETS; ++buIndex)
 	{
-		bullet.Die();
-		entity.BeHitted();
-		if (entity.GetHealth() <= 0)
+		Bullet* bullet = dynamic_cast<Bullet*> (m_bullets[buIndex]);
+		if (IsAlive(bullet))
 		{
-			entity.Die();
+			CheckBulletVsEnemies(*bullet);
 		}
-		
 	}
+
 }
 
-void Game::CheckEnemiesVsShips()
+void Game::CheckBulletVsEnemies(Bullet& bullet)
 {
-	if (m_playerShipA != nullptr)
+	Vec2 bulletStart = bullet.GetLastPosition();
+	Vec2 bulletEnd = bullet.GetPosition();
+	float bulletRadius = bullet.GetPhysicsRadius();
+	Vec2 sweptMins(fminf(bulletStart.x, bulletEnd.x) - bulletRadius, fminf(bulletStart.y, bulletEnd.y) - bulletRadius);
+	Vec2 sweptMaxs(fmaxf(bulletStart.x, bulletEnd.x) + bulletRadius, fmaxf(bulletStart.y, bulletEnd.y) + bulletRadius);
+
+	m_enemyGridQueryResults.clear();
+	m_enemyGrid.QueryItems(sweptMins, sweptMaxs, m_enemyGridQueryResults);
+
+	// a bullet hits whichever enemy it reaches first during the step, not whichever is first in a list
+	Entity* firstHit = nullptr;
+	float firstHitTime = 2.f;
+	for (int resultIndex = 0; resultIndex < static_cast<int>(m_enemyGridQueryResults.size()); ++resultIndex)
+	{
+		Entity* entity = m_enemyGridEntities[m_enemyGridQueryResults[resultIndex]];
+		if (!IsAlive(entity))
+		{
+			continue;
+		}
+
+		float timeOfImpact = 0.f;
+		if (GetMovingDiscsTimeOfImpact2D(bulletStart, bulletEnd, bulletRadius,
+										 entity->GetLastPosition(), entity->GetPosition(), entity->GetPhysicsRadius(), timeOfImpact)
+			&& timeOfImpact < firstHitTime)
+		{
+			firstHit = entity;
+			firstHitTime = timeOfImpact;
+		}
+	}
+
+	if (firstHit)
 	{
-		CheckEnemyListVsShips(MAX_ASTEROIDS, m_asteroids);
-		CheckEnemyListVsShips(MAX_BETTLES, m_beetles);
-		CheckEnemyListVsShips(MAX_WASPS, m_wasps);
+		bullet.SetPosition(bulletStart + (bulletEnd - bulletStart) * firstHitTime);
+		bullet.Die();
+		firstHit->BeHitted();
+		if (firstHit->GetHealth() <= 0)
+		{
+			firstHit->Die();
+		}
 	}
-	
+}
+
+void Game::CheckEnemiesVsShips()
+{
+	CheckEnemyListVsShips(MAX_ASTEROIDS, m_asteroids);
+	CheckEnemyListVsShips(MAX_BETTLES, m_beetles);
+	CheckEnemyListVsShips(MAX_WASPS, m_wasps);
 }
 
 void Game::CheckEnemyListVsShips(int listSize, Entity* list[])
@@ -1344,22 +1868,12 @@ void Game::CheckEnemyListVsShips(int listSize, Entity* list[])
 		Entity* entity = list[entityIndex];
 		if (entity)
 		{
-			if (m_playerShipA != nullptr)
+			for (int playerIndex = 0; playerIndex < m_numPlayers; ++playerIndex)
 			{
-				if (!m_playerShipA->m_isInvisible)
+				PlayerShip* ship = m_playerShips[playerIndex];
+				if (!ship->m_isInvisible)
 				{
-					CheckEnemyVsShip(*entity, *m_playerShipA);
-				}
-			}
-
-			if (m_multiplayer)
-			{
-				if (m_playerShipB != nullptr)
-				{
-					if (!m_playerShipB->m_isInvisible) 
-					{
-						CheckEnemyVsShip(*entity, *m_playerShipB);
-					}
+					CheckEnemyVsShip(*entity, *ship);
 				}
 			}
 		}
@@ -1383,9 +1897,20 @@ void Game::CheckEnemyVsShip(Entity& entity, PlayerShip& ship)
 	}
 }
 
+void Game::CheckShipsVsShips()
+{
+	for (int playerIndexA = 0; playerIndexA < m_numPlayers; ++playerIndexA)
+	{
+		for (int playerIndexB = playerIndexA + 1; playerIndexB < m_numPlayers; ++playerIndexB)
+		{
+			CheckShipVsShip(*m_playerShips[playerIndexA], *m_playerShips[playerIndexB]);
+		}
+	}
+}
+
 void Game::CheckShipVsShip(PlayerShip& shipA, PlayerShip& shipB)
 {
-	if (DoEntitiesOverlap(shipA, shipB) && m_multiplayer)
+	if (DoEntitiesOverlap(shipA, shipB))
 	{
 		if (shipA.IsAlive() && shipB.IsAlive())
 		{
@@ -4,10 +4,25 @@
 #include "Game/GameCommon.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Core/Rgba8.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Game/SpatialGrid.hpp"
+#include "Game/GameCommandBuffer.hpp"
+#include "Game/TaskGraph.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/RenderCommandList.hpp"
+#include "Game/RenderPrepThread.hpp"
+#include "Game/MeshLibrary.hpp"
+#include "Game/Starfield.hpp"
+#include "Game/HudLayer.hpp"
+#include "Game/DebugDrawBatch.hpp"
+#include "Game/Minimap.hpp"
+#include "Game/FrameRecorder.hpp"
+#include "Game/FramePacer.hpp"
+#include "Game/QualityGovernor.hpp"
+#include <vector>
 
 
 class App;
@@ -15,12 +30,47 @@ class PlayerShip;
 class Asteroid;
 class Bullet;
 class Debris;
+struct DebrisRolls;
 class Bettle;
 class Wasp;
-class Star;
 class Entity;
 
-
+//-----------------------------------------------------------------------------------------------
+// Slots of m_hud, in no particular order; draw order is the order they are added each frame.
+//
+enum HudElementId
+{
+	HUD_KEYBOARD_HELP,
+	HUD_MENU_HELP,
+	HUD_DIVIDERS,
+	HUD_LIVES_FIRST,
+	HUD_CONTROLLER_HELP_FIRST = HUD_LIVES_FIRST + MAX_PLAYERS,
+	HUD_RESPAWN_FIRST = HUD_CONTROLLER_HELP_FIRST + MAX_PLAYERS,
+	HUD_GAME_OVER = HUD_RESPAWN_FIRST + MAX_PLAYERS,
+	HUD_YOU_WIN,
+	HUD_ATTRACT_START,
+	HUD_ATTRACT_PLAYERS,
+	NUM_HUD_ELEMENTS
+};
+
+//-----------------------------------------------------------------------------------------------
+// Everything a frame is drawn from, reduced to what changes. Two frames with equal keys look the
+// same, so the second can replay the first instead of being rebuilt.
+//
+struct IdleFrameKey
+{
+	bool			m_isAttractMode = false;
+	bool			m_isDebugActive = false;
+	int				m_numPlayers = 0;
+	int				m_qualityLevel = 0;
+	unsigned int	m_snapshotVersion = 0;
+	unsigned int	m_hudVersion = 0;
+	unsigned int	m_minimapVersion = 0;
+	float			m_movePeriod = 0.f;
+	float			m_blinkPeriod = 0.f;
+
+	bool operator==(IdleFrameKey const& other) const;
+};
 
 class Game 
 {
@@ -31,13 +81,14 @@ public:
 	void Startup();
 
 	void Update();
-	void AddCameraShakeTrauma(float shake, bool isPlayerA);
+	void AddCameraShakeTrauma(float shake, int playerIndex);
 	
 	void Render() const;
+	FramePacingMode GetFramePacingMode() const;
 	
 	void PlayMusic();
 	void Shutdown();
-	void DebugRender() const;
+	void DebugRender(RenderSnapshot const& snapshot, int viewIndex, float viewportWidthPixels) const;
 
 	void HandleInput();
 	
@@ -47,23 +98,27 @@ public:
 	void SpawnBullet(Vec2 const& position, float orientationDegrees, Vec2 velocity);
 	void SpawnBullets(Vec2 const& position, float orientationDegrees, Vec2 velocity,int numberOfBullets, float spreadAngle);
 
-	void SpawnNewDebris(Vec2 const& position, Vec2 const& velocity, float radius, Rgba8 const& color);
+	void SpawnNewDebris(Vec2 const& position, Vec2 const& velocity, float radius, Rgba8 const& color, DebrisRolls const& rolls);
 	void SpawnNewDebrisCluster(int numDebris, Vec2 const& position, Vec2 const& averageVelocity, float spraySpeed, float radius, Rgba8 const& color);
 
 	PlayerShip* GetPlayership(int shipIndex) const;
+	PlayerShip* FindNearestTargetableShip(Vec2 const& position) const;
+	GameCommandBuffer& GetCommandBuffer() { return m_commandBuffers[GetCommandBufferIndex()]; }
 	static bool Event_KeysAndFuncs(EventArgs& args);
 	static bool Event_SetTimeScale(EventArgs& args);
+	static bool Event_TaskGraphProfile(EventArgs& args);
+	static bool Event_BenchTransform(EventArgs& args);
+	static bool Event_SaveFrame(EventArgs& args);
+	static bool Event_Quality(EventArgs& args);
 
 public:
 	App* m_App = nullptr;
-	PlayerShip* m_playerShipA = nullptr;
-	PlayerShip* m_playerShipB = nullptr;
+	PlayerShip* m_playerShips[MAX_PLAYERS] = {};
 	Entity* m_bullets[MAX_BULLETS] = {};
 	Entity* m_asteroids[MAX_ASTEROIDS] = {};
 	Entity* m_debris[MAX_DEBRIS] = {};
 	Entity* m_beetles[MAX_BETTLES] = {};
 	Entity* m_wasps[MAX_WASPS] = {};
-	Entity* m_stars[MAX_STARS] = {};
 	RandomNumberGenerator* m_rng = nullptr;
 	Vertex_PCU m_startIcon[3];
 	bool m_isDebugActive = false;
@@ -78,65 +133,98 @@ public:
 	const int m_maxWaves = 5;
 	bool m_waveComplete = true;
 	Camera m_screenCamera;
-	Camera m_worldCameraA;
-	Camera m_worldCameraB;
-	float m_worldCamShakeTraumaA;
-	float m_worldCamShakeTraumaB;
+	Camera m_worldCameras[MAX_PLAYERS];
+	AABB2 m_worldCameraBounds[MAX_PLAYERS];
+	float m_worldCamShakeTraumas[MAX_PLAYERS] = {};
 	bool m_gameOver;
 	bool m_gameMusicStart = false;
-	SoundPlaybackID m_musicPlayback;
-	SoundID m_music;
-	SoundPlaybackID m_startPlayback;
-	SoundID m_start;
+	AudioHandle m_musicPlayback = INVALID_AUDIO_HANDLE;
+	AudioHandle m_startPlayback = INVALID_AUDIO_HANDLE;
+	float m_musicVolume = 0.f;
 	bool m_win;
 	bool m_lose;
-	bool m_multiplayer = false;
+	int m_numPlayers = 1;
 	bool m_muteMusic = false;
 	bool m_isConsoleOpen = false;
 	Clock* m_clock = nullptr;
 	ViewportData m_fullport;
-	ViewportData m_leftport;
-	ViewportData m_rightport;
+	SpatialGrid m_enemyGrid = SpatialGrid(Vec2(0.f, 0.f), Vec2(WORLD_SIZE_X, WORLD_SIZE_Y), BROADPHASE_CELL_SIZE);
+	std::vector<Entity*> m_enemyGridEntities;
+	Minimap m_minimap = Minimap(AABB2(700.f, 10.f, 900.f, 110.f), Vec2(WORLD_SIZE_X, WORLD_SIZE_Y));
+	std::vector<int> m_enemyGridQueryResults;
+	GameCommandBuffer m_commandBuffers[MAX_COMMAND_BUFFERS];
+	TaskGraph* m_updateGraph = nullptr;
+	float m_updateDeltaSeconds = 0.f;
+	MeshLibrary m_meshLibrary;
+	Starfield m_starfield;
+	mutable DebugDrawBatch m_debugDraw;
+	QualityGovernor m_qualityGovernor;
+	HudLayer m_hud = HudLayer(NUM_HUD_ELEMENTS);
+	RenderSnapshot m_renderSnapshots[2];
+	RenderCommandList m_worldCommandLists[2][MAX_RENDER_VIEWS];
+	RenderPrepThread* m_renderPrepThread = nullptr;
+	int m_readyRenderIndex = 0;
+	unsigned int m_readySnapshotVersion = 0;
+	unsigned int m_prepSnapshotVersion = 0;
+	float m_attractStepSeconds = 0.f;
+	mutable FrameRecorder m_frameRecorder;
+	mutable IdleFrameKey m_recordedFrameKey;
+	mutable bool m_hasRecordedFrame = false;
 
 private:
 
 	void InitializeStartIcon();
 
 	void InitializePortData();
-	void UpdateEntities(float deltaSeconds);
+	void BuildUpdateGraph();
+	void UpdateShips(float deltaSeconds);
 	void UpdateEntityList(int listMaxSize, Entity* list[], bool checkOverlap, float deltaSeconds);
 	void UpdateAttractMode(float deltaSeconds);
+	void StepAttractAnimation(float deltaSeconds);
 	void UpdateWave(float deltaSeconds);
-	void UpdateACameras(float deltaSeconds);
-	void UpdateBCameras(float deltaSeconds);
+	void UpdateWorldCameras(float deltaSeconds);
+	void UpdateWorldCamera(int playerIndex, float deltaSeconds);
 	void UpdateMusic(float deltaSeconds);
+	void UpdateHud();
+	void ApplyQualitySettings();
+	void UpdateMinimap(float deltaSeconds);
+	void AddHealthHud();
+	void AddTutorialHud();
+	void AddAttractHud();
 
 
+	void RenderFrame() const;
+	IdleFrameKey GetIdleFrameKey() const;
+	bool ShouldRecordFrame() const;
 	void RenderAttractMode() const;
 	void RenderUI() const;
-	void RenderHealth() const;
-	void RenderTutorialUI() const;
 	void RenderFakeShip(float scale, float rotationDegrees, Vec2 translation, Rgba8 color) const;
+	void AddVertsForFakeShip(std::vector<Vertex_PCU>& verts, float scale, float rotationDegrees, Vec2 translation, Rgba8 color) const;
 	void RenderGame() const;
+	AABB2 GetPlayerScreenBounds(int playerIndex, int numPlayers) const;
+	ViewportData GetPlayerViewport(int playerIndex, int numPlayers) const;
 	void RenderDevConsole() const;
-	void RenderEntities() const;
-	void RenderEntityList(int listMaxSize, Entity* const list[]) const;
-	void RenderShip(PlayerShip* ship) const;
+	void PublishRenderSnapshot();
+	void ExtractRenderSnapshot(RenderSnapshot& snapshot) const;
+	void ExtractEntityList(int listMaxSize, Entity* const list[], RenderSnapshot& snapshot) const;
+	void ExtractShip(PlayerShip* ship, RenderSnapshot& snapshot) const;
+	void ExtractDebugShapes(DebugShapeList& debugShapes) const;
 
 	void SpawnNewWave();
-	void SpawnRandomBackground();
 	void HandleWaveComplete();
 	void HandleGameOver();
 	void HandleGameWinOrLose();
 	void CheckWaveEnd();
 
 
+	void BuildEnemyGrid();
+	void AddEnemyListToGrid(int listMaxSize, Entity* list[]);
 	void CheckBulletsVsEnemies();
-	void CheckBulletVsEnemyList(Bullet* bullet, int listMaxSize, Entity* list[]);
-	void CheckBulletVsEnemy(Bullet& bullet, Entity& entity);
+	void CheckBulletVsEnemies(Bullet& bullet);
 	void CheckEnemiesVsShips();
 	void CheckEnemyListVsShips(int listMaxSize, Entity* list[]);
 	void CheckEnemyVsShip(Entity& entity, PlayerShip& ship);
+	void CheckShipsVsShips();
 	void CheckShipVsShip(PlayerShip& shipA, PlayerShip& shipB);
 	bool DoEntitiesOverlap(Entity const& a, Entity const& b);
 
@@ -144,6 +232,8 @@ private:
 	bool IsAlive(Entity* entity) const;
 
 
+	void ApplyCommandBuffers();
+	void ApplyCommand(GameCommand const& command);
 	void DeleteGarbages();
 	void DeleteGarbageList(int listMaxSize, Entity* list[]);
 	
@@ -0,0 +1,83 @@
+#include "Game/GameCommandBuffer.hpp"
+
+thread_local int t_simTaskIndex = -1;
+
+GameCommandBuffer::GameCommandBuffer()
+{
+	m_commands.reserve(COMMAND_BUFFER_INITIAL_CAPACITY);
+}
+
+GameCommandBuffer::~GameCommandBuffer()
+{
+}
+
+void GameCommandBuffer::SpawnBullet(Vec2 const& position, float orientationDegrees, Vec2 const& velocity)
+{
+	GameCommand command;
+	command.m_type = GameCommandType::SPAWN_BULLET;
+	command.m_position = position;
+	command.m_orientationDegrees = orientationDegrees;
+	command.m_velocity = velocity;
+	m_commands.push_back(command);
+}
+
+void GameCommandBuffer::SpawnBulletSpread(Vec2 const& position, float orientationDegrees, Vec2 const& velocity, int numberOfBullets, float spreadAngle)
+{
+	GameCommand command;
+	command.m_type = GameCommandType::SPAWN_BULLET_SPREAD;
+	command.m_position = position;
+	command.m_orientationDegrees = orientationDegrees;
+	command.m_velocity = velocity;
+	command.m_count = numberOfBullets;
+	command.m_amount = spreadAngle;
+	m_commands.push_back(command);
+}
+
+void GameCommandBuffer::SpawnDebrisCluster(int numDebris, Vec2 const& position, Vec2 const& averageVelocity, float spraySpeed, float radius, Rgba8 const& color)
+{
+	GameCommand command;
+	command.m_type = GameCommandType::SPAWN_DEBRIS_CLUSTER;
+	command.m_count = numDebris;
+	command.m_position = position;
+	command.m_velocity = averageVelocity;
+	command.m_amount = spraySpeed;
+	command.m_radius = radius;
+	command.m_color = color;
+	m_commands.push_back(command);
+}
+
+void GameCommandBuffer::Despawn(Entity* entity)
+{
+	GameCommand command;
+	command.m_type = GameCommandType::DESPAWN_ENTITY;
+	command.m_entity = entity;
+	m_commands.push_back(command);
+}
+
+void GameCommandBuffer::PlaySound(SoundId sound, float volume)
+{
+	GameCommand command;
+	command.m_type = GameCommandType::PLAY_SOUND;
+	command.m_sound = sound;
+	command.m_amount = volume;
+	m_commands.push_back(command);
+}
+
+void GameCommandBuffer::AddCameraShake(float shake, int playerIndex)
+{
+	GameCommand command;
+	command.m_type = GameCommandType::ADD_CAMERA_SHAKE;
+	command.m_amount = shake;
+	command.m_playerIndex = playerIndex;
+	m_commands.push_back(command);
+}
+
+void SetSimTaskIndex(int taskIndex)
+{
+	t_simTaskIndex = taskIndex;
+}
+
+int GetSimTaskIndex()
+{
+	return t_simTaskIndex;
+}
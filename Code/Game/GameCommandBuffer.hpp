@@ -0,0 +1,73 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Game/GameCommon.hpp"
+#include <vector>
+
+class Entity;
+
+constexpr int MAX_SIM_WORKERS = 8;
+constexpr int MAX_COMMAND_BUFFERS = 32;		// one for code outside any task, then one per sim task
+constexpr int COMMAND_BUFFER_INITIAL_CAPACITY = 1024;
+
+enum class GameCommandType
+{
+	SPAWN_BULLET,
+	SPAWN_BULLET_SPREAD,
+	SPAWN_DEBRIS_CLUSTER,
+	DESPAWN_ENTITY,
+	PLAY_SOUND,
+	ADD_CAMERA_SHAKE,
+};
+
+//-----------------------------------------------------------------------------------------------
+// One deferred side effect. Fields are shared between command types; see GameCommandBuffer for
+// which fields each type uses.
+//
+struct GameCommand
+{
+	GameCommandType	m_type = GameCommandType::PLAY_SOUND;
+	Vec2			m_position;
+	Vec2			m_velocity;
+	float			m_orientationDegrees = 0.f;
+	float			m_amount = 0.f;
+	float			m_radius = 0.f;
+	int				m_count = 0;
+	Rgba8			m_color;
+	int				m_playerIndex = ALL_PLAYERS;
+	SoundId			m_sound = SOUND_BACK;
+	Entity*			m_entity = nullptr;
+};
+
+//-----------------------------------------------------------------------------------------------
+// Side effects requested during update and collision (spawns, despawns, sounds, camera shake).
+// Each sim task records into its own buffer, so recording never locks; Game applies every
+// buffer in task order at a single sync point per tick. A task runs on one thread from start to
+// finish, so its commands come out in the same order every run, whichever worker picked it up
+// and however many workers there are.
+//
+class GameCommandBuffer
+{
+public:
+	GameCommandBuffer();
+	~GameCommandBuffer();
+
+	void SpawnBullet(Vec2 const& position, float orientationDegrees, Vec2 const& velocity);
+	void SpawnBulletSpread(Vec2 const& position, float orientationDegrees, Vec2 const& velocity, int numberOfBullets, float spreadAngle);
+	void SpawnDebrisCluster(int numDebris, Vec2 const& position, Vec2 const& averageVelocity, float spraySpeed, float radius, Rgba8 const& color);
+	void Despawn(Entity* entity);
+	void PlaySound(SoundId sound, float volume);
+	void AddCameraShake(float shake, int playerIndex);
+
+	void Clear() { m_commands.clear(); }
+	bool IsEmpty() const { return m_commands.empty(); }
+	std::vector<GameCommand> const& GetCommands() const { return m_commands; }
+
+private:
+	std::vector<GameCommand> m_commands;
+};
+
+// Index of the TaskGraph task running on this thread, or -1 outside any task
+void	SetSimTaskIndex(int taskIndex);
+int		GetSimTaskIndex();
+inline int GetCommandBufferIndex() { return GetSimTaskIndex() + 1; }
@@ -1,67 +1,14 @@
 ﻿#include "Game/GameCommon.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <math.h>
+#include <vector>
 
-extern Renderer* g_theRenderer;
-
-void DebugDrawRing(Vec2 const& center, float radius, float thickness, Rgba8 const& color)
+void DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes)
 {
-	float halfThickness = 0.5f * thickness;
-
-	float innerRadius = radius - halfThickness;
-	float outerRadius = radius + halfThickness;
-
-	constexpr int NUM_SIDES = 32;
-	constexpr int NUM_TRIS = 2 * NUM_SIDES;
-	constexpr int NUM_VERTS = 3 * NUM_TRIS;
-
-	Vertex_PCU verts[NUM_VERTS];
-
-	constexpr float DEGREES_PER_SIDE = 360.f / static_cast<float>(NUM_SIDES);
-
-	for (int sideNum = 0; sideNum < NUM_SIDES; ++sideNum)
-	{
-		float startDegrees = DEGREES_PER_SIDE * static_cast<float>(sideNum);
-		float endDegrees = DEGREES_PER_SIDE * static_cast<float>(sideNum + 1);
-
-		float cosStart = CosDegrees(startDegrees);
-		float sinStart = SinDegrees(startDegrees);
-		float cosEnd = CosDegrees(endDegrees);
-		float sinEnd = SinDegrees(endDegrees);
-
-
-		Vec3 inneerStartPos = Vec3(center.x + innerRadius * cosStart, center.y + innerRadius * sinStart, 0.f);
-		Vec3 outerStartPos = Vec3(center.x + outerRadius * cosStart, center.y + outerRadius * sinStart, 0.f);
-		Vec3 outerEndPos = Vec3(center.x + outerRadius * cosEnd, center.y + outerRadius * sinEnd, 0.f);
-		Vec3 innerEndPos = Vec3(center.x + innerRadius * cosEnd, center.y + innerRadius * sinEnd, 0.f);
-
-		int vertIndexA = (6 * sideNum) + 0;
-		int vertIndexB = (6 * sideNum) + 1;
-		int vertIndexC = (6 * sideNum) + 2;
-		int vertIndexD = (6 * sideNum) + 3;
-		int vertIndexE = (6 * sideNum) + 4;
-		int vertIndexF = (6 * sideNum) + 5;
-
-		verts[vertIndexA].m_position = innerEndPos;
-		verts[vertIndexB].m_position = inneerStartPos;
-		verts[vertIndexC].m_position = outerStartPos;
-
-		verts[vertIndexA].m_color = color;
-		verts[vertIndexB].m_color = color;
-		verts[vertIndexC].m_color = color;
-
-
-		verts[vertIndexD].m_position = innerEndPos;
-		verts[vertIndexE].m_position = outerStartPos;
-		verts[vertIndexF].m_position = outerEndPos;
-
-		verts[vertIndexD].m_color = color;
-		verts[vertIndexE].m_color = color;
-		verts[vertIndexF].m_color = color;
-	}
-
-	g_theRenderer->DrawVertexArray(NUM_VERTS, verts);
+	g_theRenderBackend->DrawIndexedVertexArray(numVerts, verts, numIndexes, indexes);
 }
 
-void DebugDrawLine(Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color)
+static void FillLineVerts(Vertex_PCU* out_verts, Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color)
 {
 	float h = thickness * 0.5f;
 
@@ -75,21 +22,64 @@ void DebugDrawLine(Vec2 const& startPos, Vec2 const& endPos, float thickness, Rg
 	Vec2 bottomLeft = startPos - stepFwd + stepLeft;
 	Vec2 bottomRight = startPos - stepFwd - stepLeft;
 
-	Vertex_PCU verts[6];
+	out_verts[0].m_position = Vec3(bottomLeft.x, bottomLeft.y, 0.f);
+	out_verts[1].m_position = Vec3(topLeft.x, topLeft.y, 0.f);
+	out_verts[2].m_position = Vec3(topRight.x, topRight.y, 0.f);
 
-	verts[0].m_position = Vec3(bottomLeft.x, bottomLeft.y, 0.f);
-	verts[1].m_position = Vec3(topLeft.x, topLeft.y, 0.f);
-	verts[2].m_position = Vec3(topRight.x, topRight.y, 0.f);
-
-	verts[3].m_position = Vec3(bottomLeft.x, bottomLeft.y, 0.f);
-	verts[4].m_position = Vec3(topRight.x, topRight.y, 0.f);
-	verts[5].m_position = Vec3(bottomRight.x, bottomRight.y, 0.f);
+	out_verts[3].m_position = Vec3(bottomLeft.x, bottomLeft.y, 0.f);
+	out_verts[4].m_position = Vec3(topRight.x, topRight.y, 0.f);
+	out_verts[5].m_position = Vec3(bottomRight.x, bottomRight.y, 0.f);
 
 	for (int i = 0; i < 6; ++i)
 	{
-		verts[i].m_color = color;
+		out_verts[i].m_color = color;
 	}
+}
 
-	g_theRenderer->DrawVertexArray(6, verts);
+void AddVertsForLine2D(std::vector<Vertex_PCU>& verts, Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color)
+{
+	size_t firstVert = verts.size();
+	verts.resize(firstVert + 6);
+	FillLineVerts(&verts[firstVert], startPos, endPos, thickness, color);
 }
 
+//-----------------------------------------------------------------------------------------------
+// Continuous disc-vs-disc test over one step where both discs move linearly from start to end.
+// Returns true on contact; out_timeOfImpact is the first contact time as a fraction of the step.
+//
+bool GetMovingDiscsTimeOfImpact2D(Vec2 const& startA, Vec2 const& endA, float radiusA,
+								  Vec2 const& startB, Vec2 const& endB, float radiusB, float& out_timeOfImpact)
+{
+	Vec2 separation = startA - startB;
+	Vec2 relativeMotion = (endA - startA) - (endB - startB);
+	float combinedRadius = radiusA + radiusB;
+
+	float c = (separation.x * separation.x + separation.y * separation.y) - (combinedRadius * combinedRadius);
+	if (c <= 0.f)
+	{
+		out_timeOfImpact = 0.f;
+		return true;
+	}
+
+	float a = relativeMotion.x * relativeMotion.x + relativeMotion.y * relativeMotion.y;
+	float b = separation.x * relativeMotion.x + separation.y * relativeMotion.y;
+	if (a <= 0.f || b >= 0.f)
+	{
+		return false;
+	}
+
+	float discriminant = (b * b) - (a * c);
+	if (discriminant < 0.f)
+	{
+		return false;
+	}
+
+	float timeOfImpact = (-b - sqrtf(discriminant)) / a;
+	if (timeOfImpact > 1.f)
+	{
+		return false;
+	}
+
+	out_timeOfImpact = timeOfImpact;
+	return true;
+}
@@ -6,10 +6,17 @@
 #include <Engine/Renderer/Renderer.hpp>
 #include <Engine/Math/MathUtils.hpp>
 #include "Engine/Core/Vertex_PCU.hpp"
+#include "Game/RenderBackend.hpp"
+#include "Game/AudioThread.hpp"
+#include <vector>
 
 class Renderer;
+class SoftwareRasterizer;
 
 extern Renderer* g_theRenderer;
+extern RenderBackend* g_theRenderBackend;
+extern SoftwareRasterizer* g_theSoftwareRasterizer;	// g_theRenderBackend when softwareRenderer="true", otherwise null
+extern AudioThread* g_theAudioThread;
 
 constexpr int NUM_STARTING_ASTEROIDS = 6;
 constexpr int MAX_ASTEROIDS = 400;
@@ -19,7 +26,6 @@ constexpr int MAX_BETTLES = 100;
 constexpr int MAX_WASPS = 100;
 constexpr float WORLD_SIZE_X = 1000;
 constexpr float WORLD_SIZE_Y = 500;
-constexpr int MAX_STARS = 100;
 constexpr float SCREEN_SIZE_X = 1600;
 constexpr float SCREEN_SIZE_Y = 800;
 constexpr float WORLD_CENTER_X = WORLD_SIZE_X / 2.f;
@@ -46,11 +52,18 @@ constexpr float DEBRIS_LIFETIME_SECONDS = 2.0f;
 constexpr float DEBRIS_SCALE = 0.5f;
 constexpr float CAM_SHAKE_REDUCTION_PER_SECOND = 0.5f;
 constexpr float CAM_SHAKE_MAX = 1.f;
+constexpr float BROADPHASE_CELL_SIZE = 8.f;
+constexpr float ATTRACT_ANIMATION_STEP_SECONDS = 0.05f;	// attract screen animates in fixed steps; frames between steps repeat
+constexpr int MAX_PLAYERS = 4;
+constexpr int ALL_PLAYERS = -1;
 
 
 
 
 
-void DebugDrawRing(Vec2 const& center, float radius, float thickness, Rgba8 const& color);
+void DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes);
 
-void DebugDrawLine(Vec2 const& S, Vec2 const& E, float thickness, Rgba8 const& color);
\ No newline at end of file
+void AddVertsForLine2D(std::vector<Vertex_PCU>& verts, Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color);
+
+bool GetMovingDiscsTimeOfImpact2D(Vec2 const& startA, Vec2 const& endA, float radiusA,
+								  Vec2 const& startB, Vec2 const& endB, float radiusB, float& out_timeOfImpact);
@@ -0,0 +1,170 @@
+#include "Game/HudLayer.hpp"
+#include "Game/RenderBackend.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+
+extern RenderBackend* g_theRenderBackend;
+extern BitmapFont* g_theFont;
+
+HudLayer::HudLayer(int numElements)
+	: m_elements(numElements)
+{
+	m_frameElementIds.reserve(numElements);
+	m_packedElementIds.reserve(numElements);
+}
+
+void HudLayer::BeginFrame()
+{
+	m_frameElementIds.clear();
+}
+
+void HudLayer::AddText(int elementId, char const* text, Vec2 const& mins, float cellHeight, Rgba8 const& color, float cellAspect)
+{
+	m_frameElementIds.push_back(elementId);
+
+	HudElement& element = m_elements[elementId];
+	bool isLayoutCached = element.m_isBuilt && !element.m_isWidget && element.m_text == text && element.m_mins == mins &&
+						  element.m_cellHeight == cellHeight && element.m_cellAspect == cellAspect &&
+						  element.m_color.r == color.r && element.m_color.g == color.g && element.m_color.b == color.b;
+	if (!isLayoutCached)
+	{
+		element.m_isBuilt = true;
+		element.m_isWidget = false;
+		element.m_text = text;
+		element.m_mins = mins;
+		element.m_cellHeight = cellHeight;
+		element.m_cellAspect = cellAspect;
+		element.m_color = color;
+		BuildText(element);
+		m_isPackDirty = true;
+		return;
+	}
+
+	if (element.m_color.a != color.a)
+	{
+		element.m_color.a = color.a;
+		int numVerts = static_cast<int>(element.m_verts.size());
+		for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+		{
+			element.m_verts[vertIndex].m_color.a = color.a;
+		}
+		if (!m_isPackDirty && element.m_firstPackedVert >= 0)
+		{
+			Vertex_PCU* packedVerts = &GetPackedVerts(element)[element.m_firstPackedVert];
+			for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+			{
+				packedVerts[vertIndex].m_color.a = color.a;
+			}
+			++m_version;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Returns the widget's cleared vertex list when contentKey differs from the one it was built
+// with, for the caller to refill; nullptr when the cached vertices are still good.
+//
+std::vector<Vertex_PCU>* HudLayer::AddWidget(int elementId, unsigned int contentKey)
+{
+	m_frameElementIds.push_back(elementId);
+
+	HudElement& element = m_elements[elementId];
+	if (element.m_isBuilt && element.m_isWidget && element.m_contentKey == contentKey)
+	{
+		return nullptr;
+	}
+
+	element.m_isBuilt = true;
+	element.m_isWidget = true;
+	element.m_contentKey = contentKey;
+	element.m_text.clear();
+	element.m_verts.clear();
+	m_isPackDirty = true;
+	return &element.m_verts;
+}
+
+void HudLayer::EndFrame()
+{
+	if (m_frameElementIds != m_packedElementIds)
+	{
+		m_isPackDirty = true;
+	}
+	if (!m_isPackDirty)
+	{
+		return;
+	}
+
+	for (int packedIndex = 0; packedIndex < static_cast<int>(m_packedElementIds.size()); ++packedIndex)
+	{
+		m_elements[m_packedElementIds[packedIndex]].m_firstPackedVert = -1;
+	}
+
+	m_packedShapeVerts.clear();
+	m_packedTextVerts.clear();
+	for (int frameIndex = 0; frameIndex < static_cast<int>(m_frameElementIds.size()); ++frameIndex)
+	{
+		HudElement& element = m_elements[m_frameElementIds[frameIndex]];
+		std::vector<Vertex_PCU>& packedVerts = GetPackedVerts(element);
+		element.m_firstPackedVert = static_cast<int>(packedVerts.size());
+		packedVerts.insert(packedVerts.end(), element.m_verts.begin(), element.m_verts.end());
+	}
+	m_packedElementIds = m_frameElementIds;
+	m_isPackDirty = false;
+	++m_version;
+}
+
+void HudLayer::Render() const
+{
+	if (!m_packedShapeVerts.empty())
+	{
+		g_theRenderBackend->BindTexture(nullptr);
+		g_theRenderBackend->DrawVertexArray(static_cast<int>(m_packedShapeVerts.size()), m_packedShapeVerts.data());
+	}
+	if (!m_packedTextVerts.empty() && g_theFont)
+	{
+		g_theRenderBackend->BindTexture(&g_theFont->GetTexture());
+		g_theRenderBackend->DrawVertexArray(static_cast<int>(m_packedTextVerts.size()), m_packedTextVerts.data());
+		g_theRenderBackend->BindTexture(nullptr);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Lines are separated by '\n'; each one starts HUD_LINE_SPACING cell heights below the last.
+// Tabs are laid out as single spaces rather than whatever glyph the atlas holds for them.
+// Without a font (software renderer) text elements stay empty.
+//
+void HudLayer::BuildText(HudElement& element)
+{
+	element.m_verts.clear();
+	if (g_theFont == nullptr)
+	{
+		return;
+	}
+	float glyphAspect = element.m_cellAspect * (1.f + HUD_TEXT_GLYPH_SPACING);
+	Vec2 lineMins = element.m_mins;
+	size_t lineStart = 0;
+	for (;;)
+	{
+		size_t lineEnd = element.m_text.find('\n', lineStart);
+		bool isLastLine = lineEnd == std::string::npos;
+		if (isLastLine)
+		{
+			lineEnd = element.m_text.size();
+		}
+
+		m_lineScratch.assign(element.m_text, lineStart, lineEnd - lineStart);
+		for (char& glyph : m_lineScratch)
+		{
+			if (glyph == '\t')
+			{
+				glyph = ' ';
+			}
+		}
+		g_theFont->AddVertsForText2D(element.m_verts, lineMins, element.m_cellHeight, m_lineScratch, element.m_color, glyphAspect);
+		if (isLastLine)
+		{
+			return;
+		}
+		lineMins.y -= element.m_cellHeight * HUD_LINE_SPACING;
+		lineStart = lineEnd + 1;
+	}
+}
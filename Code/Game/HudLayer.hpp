@@ -0,0 +1,70 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include <string>
+#include <vector>
+
+constexpr float HUD_TEXT_CELL_ASPECT = 0.56f;
+constexpr float HUD_TEXT_GLYPH_SPACING = 0.2f;	// gap after each glyph, in glyph widths
+constexpr float HUD_LINE_SPACING = 4.f / 3.f;	// line pitch of multi-line text, in cell heights
+
+//-----------------------------------------------------------------------------------------------
+// Retained screen-space layer for HUD text and widgets. Every frame the caller re-declares the
+// elements it wants shown, in draw order, between BeginFrame and EndFrame. Each element keeps the
+// vertices it was last built with and is rebuilt only when its string, position, size or color
+// changes; a change of alpha alone is written into the cached vertices in place. Visible elements
+// are packed into one vertex array, repacked only when something was rebuilt or the set of shown
+// elements changed, so a steady frame is a few compares and two draws and allocates nothing.
+//
+// Text is laid out as one textured quad per glyph from g_theFont's atlas. Its cell aspect plus
+// HUD_TEXT_GLYPH_SPACING gives the character advance, so strings keep the widths they had with
+// the triangle font. Widgets are untextured and packed separately, drawn beneath the text.
+//
+class HudLayer
+{
+public:
+	explicit HudLayer(int numElements);
+
+	void BeginFrame();
+	void AddText(int elementId, char const* text, Vec2 const& mins, float cellHeight, Rgba8 const& color, float cellAspect = HUD_TEXT_CELL_ASPECT);
+	std::vector<Vertex_PCU>* AddWidget(int elementId, unsigned int contentKey);
+	void EndFrame();
+
+	void Render() const;
+
+	int GetNumVerts() const { return static_cast<int>(m_packedShapeVerts.size() + m_packedTextVerts.size()); }
+	unsigned int GetVersion() const { return m_version; }	// changes whenever the packed vertices do
+
+private:
+	//-----------------------------------------------------------------------------------------------
+	// Text elements are keyed by their layout inputs; widgets by a caller-chosen content key,
+	// and the caller fills their vertices whenever AddWidget hands them back.
+	//
+	struct HudElement
+	{
+		bool					m_isBuilt = false;
+		bool					m_isWidget = false;
+		std::string				m_text;
+		Vec2					m_mins;
+		float					m_cellHeight = 0.f;
+		float					m_cellAspect = 0.f;
+		Rgba8					m_color;
+		unsigned int			m_contentKey = 0;
+		int						m_firstPackedVert = -1;
+		std::vector<Vertex_PCU>	m_verts;
+	};
+
+	void BuildText(HudElement& element);
+	std::vector<Vertex_PCU>& GetPackedVerts(HudElement const& element) { return element.m_isWidget ? m_packedShapeVerts : m_packedTextVerts; }
+
+private:
+	std::vector<HudElement>		m_elements;
+	std::vector<int>			m_frameElementIds;
+	std::vector<int>			m_packedElementIds;
+	std::vector<Vertex_PCU>		m_packedShapeVerts;
+	std::vector<Vertex_PCU>		m_packedTextVerts;
+	std::string					m_lineScratch;
+	bool						m_isPackDirty = true;
+	unsigned int				m_version = 0;
+};
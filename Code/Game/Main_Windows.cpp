@@ -4,10 +4,13 @@
 
 #define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
 #include <windows.h>			// #include this (massive, platform-specific) header in VERY few places (and .CPPs only)
+#include <timeapi.h>
 #include <math.h>
 #include <cassert>
 #include <crtdbg.h>
 
+#pragma comment(lib, "winmm.lib")	// timeBeginPeriod
+
 
 extern App* g_theApp;
 
@@ -24,6 +27,9 @@ int WINAPI WinMain( HINSTANCE applicationInstanceHandle, HINSTANCE, LPSTR comman
 	g_theApp = new App();
 	g_theApp->Startup();
 
+	// 1 ms scheduler ticks, so the frame pacer's short sleeps wake close to on time
+	timeBeginPeriod(1);
+
 	// Program main loop; keep running frames until it's time to quit
 	while(!g_theApp->IsQuitting())			
 	{
@@ -31,6 +37,7 @@ int WINAPI WinMain( HINSTANCE applicationInstanceHandle, HINSTANCE, LPSTR comman
 		g_theApp->RunFrame();
 
 	}
+	timeEndPeriod(1);
 	g_theApp->Shutdown();
 	delete g_theApp;
 	g_theApp = nullptr;
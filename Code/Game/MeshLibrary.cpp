@@ -0,0 +1,245 @@
+#include "Game/MeshLibrary.hpp"
+#include "Game/Asteroid.hpp"
+#include "Game/BatchTransform.hpp"
+#include "Game/Beetle.hpp"
+#include "Game/Bullet.hpp"
+#include "Game/Debris.hpp"
+#include "Game/PlayerShip.hpp"
+#include "Game/Starfield.hpp"
+#include "Game/Wasp.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+
+//-----------------------------------------------------------------------------------------------
+// Steps one LOD at a time from previousLod, and only once pixelRadius is past a threshold by
+// MESH_LOD_HYSTERESIS, so a radius hovering at a threshold does not flicker between two LODs.
+//
+int SelectMeshLod(float pixelRadius, int previousLod)
+{
+	int lod = previousLod;
+	while (lod < NUM_MESH_LODS - 1 && pixelRadius < MESH_LOD_PIXEL_RADII[lod] * (1.f - MESH_LOD_HYSTERESIS))
+	{
+		++lod;
+	}
+	while (lod > 0 && pixelRadius > MESH_LOD_PIXEL_RADII[lod - 1] * (1.f + MESH_LOD_HYSTERESIS))
+	{
+		--lod;
+	}
+	return lod;
+}
+
+MeshLibrary::MeshLibrary()
+{
+}
+
+MeshLibrary::~MeshLibrary()
+{
+}
+
+void MeshLibrary::Startup()
+{
+	for (int meshId = 0; meshId < NUM_LOD0_MESH_IDS; ++meshId)
+	{
+		for (int lod = 0; lod < NUM_MESH_LODS; ++lod)
+		{
+			m_lodMeshIds[meshId][lod] = static_cast<unsigned short>(meshId);
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------------
+	// Fixed shapes, in local space, as triangle lists. AddFixedMesh welds repeated corners.
+	//
+	static constexpr FixedMeshVertex s_lineMesh[] =
+	{
+		// unit quad spanning x in [0,1] and y in [-0.5,0.5]
+		{ 0.f, -0.5f, 255, 255, 255, 255 }, { 1.f, -0.5f, 255, 255, 255, 255 }, { 1.f, 0.5f, 255, 255, 255, 255 },
+		{ 0.f, -0.5f, 255, 255, 255, 255 }, { 1.f, 0.5f, 255, 255, 255, 255 }, { 0.f, 0.5f, 255, 255, 255, 255 },
+	};
+
+	static constexpr FixedMeshVertex s_flameMesh[] =
+	{
+		// relative to the ship tail, stretched along -x by the flame length
+		{ -1.f, 0.f, 255, 255, 255, 255 }, { 0.f, -1.f, 255, 255, 255, 255 }, { 0.f, 1.f, 255, 255, 255, 255 },
+	};
+
+	static constexpr FixedMeshVertex s_shipMesh[] =
+	{
+		{ 2.f, 1.f, 255, 255, 255, 255 }, { 0.f, 2.f, 255, 255, 255, 255 }, { -2.f, 1.f, 255, 255, 255, 255 },		// left wing
+		{ 0.f, 1.f, 255, 255, 255, 255 }, { -2.f, 1.f, 255, 255, 255, 255 }, { -2.f, -1.f, 255, 255, 255, 255 },		// half main
+		{ 0.f, 1.f, 255, 255, 255, 255 }, { -2.f, -1.f, 255, 255, 255, 255 }, { 0.f, -1.f, 255, 255, 255, 255 },		// half main
+		{ 1.f, 0.f, 255, 255, 255, 255 }, { 0.f, 1.f, 255, 255, 255, 255 }, { 0.f, -1.f, 255, 255, 255, 255 },		// nose
+		{ 2.f, -1.f, 255, 255, 255, 255 }, { -2.f, -1.f, 255, 255, 255, 255 }, { 0.f, -2.f, 255, 255, 255, 255 },	// right wing
+	};
+
+	static constexpr FixedMeshVertex s_bulletMesh[] =
+	{
+		{ 0.5f, 0.f, 255, 255, 255, 255 }, { 0.f, 0.5f, 255, 255, 255, 255 }, { 0.f, -0.5f, 255, 255, 255, 255 },	// head
+		{ 0.f, -0.5f, 255, 0, 0, 255 }, { 0.f, 0.5f, 255, 0, 0, 255 }, { -2.f, 0.f, 255, 0, 0, 0 },					// tail
+	};
+
+	static constexpr FixedMeshVertex s_beetleMesh[] =
+	{
+		{ 2.f, 0.f, 255, 255, 255, 255 }, { -0.5f, 2.f, 255, 255, 255, 255 }, { -2.f, 0.f, 255, 255, 255, 255 },
+		{ 2.f, 0.f, 255, 255, 255, 255 }, { -2.f, 0.f, 255, 255, 255, 255 }, { -0.5f, -2.f, 255, 255, 255, 255 },
+	};
+
+	static constexpr FixedMeshVertex s_waspMesh[] =
+	{
+		{ 3.f, 0.f, 255, 255, 255, 255 }, { -0.5f, 2.f, 255, 255, 255, 255 }, { 0.5f, 0.f, 255, 255, 255, 255 },
+		{ 3.f, 0.f, 255, 255, 255, 255 }, { 0.5f, 0.f, 255, 255, 255, 255 }, { -0.5f, -2.f, 255, 255, 255, 255 },
+	};
+
+	static constexpr FixedMeshVertex s_starMesh[] =
+	{
+		{ -3.f, 0.f, 255, 255, 255, 255 }, { -1.f, -1.f, 255, 255, 255, 255 }, { -1.f, 1.f, 255, 255, 255, 255 },
+		{ -1.f, 1.f, 255, 255, 255, 255 }, { 1.f, 1.f, 255, 255, 255, 255 }, { 0.f, 3.f, 255, 255, 255, 255 },
+		{ 1.f, 1.f, 255, 255, 255, 255 }, { 1.f, -1.f, 255, 255, 255, 255 }, { 3.f, 0.f, 255, 255, 255, 255 },
+		{ -1.f, -1.f, 255, 255, 255, 255 }, { 0.f, -3.f, 255, 255, 255, 255 }, { 1.f, -1.f, 255, 255, 255, 255 },
+		{ -1.f, -1.f, 255, 255, 255, 255 }, { 1.f, -1.f, 255, 255, 255, 255 }, { 1.f, 1.f, 255, 255, 255, 255 },
+		{ -1.f, -1.f, 255, 255, 255, 255 }, { 1.f, 1.f, 255, 255, 255, 255 }, { -1.f, 1.f, 255, 255, 255, 255 },
+	};
+
+	static_assert(sizeof(s_shipMesh) / sizeof(s_shipMesh[0]) == NUM_SHIP_VERTS, "ship mesh size mismatch");
+	static_assert(sizeof(s_bulletMesh) / sizeof(s_bulletMesh[0]) == NUM_BULLET_VERTS, "bullet mesh size mismatch");
+	static_assert(sizeof(s_beetleMesh) / sizeof(s_beetleMesh[0]) == NUM_BETTLE_VERTS, "beetle mesh size mismatch");
+	static_assert(sizeof(s_waspMesh) / sizeof(s_waspMesh[0]) == NUM_WASP_VERTS, "wasp mesh size mismatch");
+	static_assert(sizeof(s_starMesh) / sizeof(s_starMesh[0]) == NUM_STAR_VERTS, "star mesh size mismatch");
+
+	AddFixedMesh(MESH_LINE, &s_lineMesh[0], 6);
+	AddFixedMesh(MESH_FLAME, &s_flameMesh[0], 3);
+	AddFixedMesh(MESH_SHIP, &s_shipMesh[0], NUM_SHIP_VERTS);
+	AddFixedMesh(MESH_BULLET, &s_bulletMesh[0], NUM_BULLET_VERTS);
+	AddFixedMesh(MESH_BEETLE, &s_beetleMesh[0], NUM_BETTLE_VERTS);
+	AddFixedMesh(MESH_WASP, &s_waspMesh[0], NUM_WASP_VERTS);
+	AddFixedMesh(MESH_STAR, &s_starMesh[0], NUM_STAR_VERTS);
+
+	//-----------------------------------------------------------------------------------------------
+	// Random variants, from a fixed seed so every run gets the same pool
+	//
+	RandomNumberGenerator variantRng(MESH_VARIANT_SEED);
+
+	for (int variantIndex = 0; variantIndex < NUM_ASTEROID_MESH_VARIANTS; ++variantIndex)
+	{
+		Vertex_PCU asteroidVerts[NUM_ASTEROID_VERTS];
+		unsigned int asteroidIndexes[NUM_ASTEROID_INDEXES];
+		Asteroid::InitializeVerts(&asteroidVerts[0], &asteroidIndexes[0], variantRng);
+		unsigned short meshId = static_cast<unsigned short>(MESH_ASTEROID_FIRST + variantIndex);
+		AddMesh(meshId, &asteroidVerts[0], NUM_ASTEROID_VERTS, &asteroidIndexes[0], NUM_ASTEROID_INDEXES);
+		AddFanMeshLods(meshId, static_cast<unsigned short>(MESH_ASTEROID_LOD_FIRST + variantIndex * (NUM_MESH_LODS - 1)), &asteroidVerts[0], NUM_ASTEROID_TRIS);
+	}
+
+	for (int variantIndex = 0; variantIndex < NUM_DEBRIS_MESH_VARIANTS; ++variantIndex)
+	{
+		Vertex_PCU debrisVerts[NUM_DEBRIS_VERTS];
+		unsigned int debrisIndexes[NUM_DEBRIS_INDEXES];
+		Debris::InitializeVerts(&debrisVerts[0], &debrisIndexes[0], variantRng);
+		unsigned short meshId = static_cast<unsigned short>(MESH_DEBRIS_FIRST + variantIndex);
+		AddMesh(meshId, &debrisVerts[0], NUM_DEBRIS_VERTS, &debrisIndexes[0], NUM_DEBRIS_INDEXES);
+		AddFanMeshLods(meshId, static_cast<unsigned short>(MESH_DEBRIS_LOD_FIRST + variantIndex * (NUM_MESH_LODS - 1)), &debrisVerts[0], NUM_STARS_TRIS);
+	}
+
+	BuildLocalPositions();
+}
+
+void MeshLibrary::AddMesh(unsigned short meshId, Vertex_PCU const* verts, int numVerts, unsigned int const* indexes, int numIndexes)
+{
+	MeshRange& mesh = m_meshes[meshId];
+	mesh.m_firstVert = static_cast<int>(m_verts.size());
+	mesh.m_numVerts = numVerts;
+	mesh.m_firstIndex = static_cast<int>(m_indexes.size());
+	mesh.m_numIndexes = numIndexes;
+	m_verts.insert(m_verts.end(), verts, verts + numVerts);
+	m_indexes.insert(m_indexes.end(), indexes, indexes + numIndexes);
+}
+
+//-----------------------------------------------------------------------------------------------
+// Fixed tables are written as plain triangle lists; corners that repeat exactly (position and
+// color) are shared so the library only stores and transforms each one once.
+//
+void MeshLibrary::AddFixedMesh(unsigned short meshId, FixedMeshVertex const* fixedVerts, int numVerts)
+{
+	MeshRange& mesh = m_meshes[meshId];
+	mesh.m_firstVert = static_cast<int>(m_verts.size());
+	mesh.m_numVerts = 0;
+	mesh.m_firstIndex = static_cast<int>(m_indexes.size());
+	mesh.m_numIndexes = numVerts;
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		FixedMeshVertex const& fixedVert = fixedVerts[vertIndex];
+		Vec3 position(fixedVert.m_x, fixedVert.m_y, 0.f);
+		Rgba8 color(fixedVert.m_r, fixedVert.m_g, fixedVert.m_b, fixedVert.m_a);
+
+		int weldedIndex = 0;
+		while (weldedIndex < mesh.m_numVerts)
+		{
+			Vertex_PCU const& existing = m_verts[mesh.m_firstVert + weldedIndex];
+			if (existing.m_position.x == position.x && existing.m_position.y == position.y && existing.m_color == color)
+			{
+				break;
+			}
+			++weldedIndex;
+		}
+		if (weldedIndex == mesh.m_numVerts)
+		{
+			m_verts.emplace_back(position, color, Vec2(0.f, 0.f));
+			mesh.m_numVerts += 1;
+		}
+		m_indexes.push_back(static_cast<unsigned int>(weldedIndex));
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Coarser copies of a fan mesh (center vertex, then the rim): LOD n keeps every 2^n-th rim
+// vertex. A LOD that would drop below MIN_FAN_LOD_RIM_VERTS reuses the one before it, and its
+// reserved mesh id stays empty.
+//
+void MeshLibrary::AddFanMeshLods(unsigned short meshId, unsigned short firstLodMeshId, Vertex_PCU const* fanVerts, int numRimVerts)
+{
+	for (int lod = 1; lod < NUM_MESH_LODS; ++lod)
+	{
+		int stride = 1 << lod;
+		int numLodRimVerts = numRimVerts / stride;
+		if (numLodRimVerts < MIN_FAN_LOD_RIM_VERTS)
+		{
+			m_lodMeshIds[meshId][lod] = m_lodMeshIds[meshId][lod - 1];
+			continue;
+		}
+
+		unsigned short lodMeshId = static_cast<unsigned short>(firstLodMeshId + lod - 1);
+		MeshRange& mesh = m_meshes[lodMeshId];
+		mesh.m_firstVert = static_cast<int>(m_verts.size());
+		mesh.m_numVerts = numLodRimVerts + 1;
+		mesh.m_firstIndex = static_cast<int>(m_indexes.size());
+		mesh.m_numIndexes = 3 * numLodRimVerts;
+
+		m_verts.push_back(fanVerts[0]);
+		for (int rimIndex = 0; rimIndex < numLodRimVerts; ++rimIndex)
+		{
+			m_verts.push_back(fanVerts[1 + rimIndex * stride]);
+			m_indexes.push_back(static_cast<unsigned int>(rimIndex + 1));
+			m_indexes.push_back(static_cast<unsigned int>((rimIndex + 1) % numLodRimVerts + 1));
+			m_indexes.push_back(0);
+		}
+		m_lodMeshIds[meshId][lod] = lodMeshId;
+	}
+}
+
+void MeshLibrary::BuildLocalPositions()
+{
+	m_localXs.clear();
+	m_localYs.clear();
+	for (int meshId = 0; meshId < NUM_MESH_IDS; ++meshId)
+	{
+		MeshRange& mesh = m_meshes[meshId];
+		mesh.m_firstLocal = static_cast<int>(m_localXs.size());
+
+		int numPaddedVerts = GetNumBatchTransformGroups(mesh.m_numVerts) * BATCH_TRANSFORM_LANES;
+		m_localXs.resize(mesh.m_firstLocal + numPaddedVerts, 0.f);
+		m_localYs.resize(mesh.m_firstLocal + numPaddedVerts, 0.f);
+		for (int vertIndex = 0; vertIndex < mesh.m_numVerts; ++vertIndex)
+		{
+			Vertex_PCU const& vert = m_verts[mesh.m_firstVert + vertIndex];
+			m_localXs[mesh.m_firstLocal + vertIndex] = vert.m_position.x;
+			m_localYs[mesh.m_firstLocal + vertIndex] = vert.m_position.y;
+		}
+	}
+}
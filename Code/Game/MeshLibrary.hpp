@@ -0,0 +1,95 @@
+#pragma once
+#include "Game/EngineBuildPreferences.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include <vector>
+
+
+constexpr int NUM_ASTEROID_MESH_VARIANTS = 8;
+constexpr int NUM_DEBRIS_MESH_VARIANTS = 8;
+constexpr unsigned int MESH_VARIANT_SEED = 1337;
+
+constexpr int NUM_MESH_LODS = 3;										// at most 4; a proxy keeps 2 bits of LOD per view
+constexpr float MESH_LOD_PIXEL_RADII[NUM_MESH_LODS - 1] = { 12.f, 5.f };	// on-screen radius below which LOD i + 1 takes over from LOD i
+constexpr float MESH_LOD_HYSTERESIS = 0.2f;							// fraction a radius must pass a threshold by before the LOD changes
+constexpr int MIN_FAN_LOD_RIM_VERTS = 4;
+
+int SelectMeshLod(float pixelRadius, int previousLod);
+
+//-----------------------------------------------------------------------------------------------
+// Ids of the shared, immutable meshes every render proxy refers to. Asteroids and debris pick
+// one of several random variants at spawn. Mesh colors are multiplied by the proxy tint, so most
+// meshes are built white. The ids after NUM_LOD0_MESH_IDS are the coarser LODs of the variants;
+// proxies always name LOD 0 and the command list swaps in the LOD chosen for its view.
+//
+enum MeshId : unsigned short
+{
+	MESH_LINE,
+	MESH_FLAME,
+	MESH_SHIP,
+	MESH_BULLET,
+	MESH_BEETLE,
+	MESH_WASP,
+	MESH_STAR,
+	MESH_ASTEROID_FIRST,
+	MESH_DEBRIS_FIRST = MESH_ASTEROID_FIRST + NUM_ASTEROID_MESH_VARIANTS,
+	NUM_LOD0_MESH_IDS = MESH_DEBRIS_FIRST + NUM_DEBRIS_MESH_VARIANTS,
+	MESH_ASTEROID_LOD_FIRST = NUM_LOD0_MESH_IDS,
+	MESH_DEBRIS_LOD_FIRST = MESH_ASTEROID_LOD_FIRST + NUM_ASTEROID_MESH_VARIANTS * (NUM_MESH_LODS - 1),
+	NUM_MESH_IDS = MESH_DEBRIS_LOD_FIRST + NUM_DEBRIS_MESH_VARIANTS * (NUM_MESH_LODS - 1)
+};
+
+//-----------------------------------------------------------------------------------------------
+// All game meshes packed into one indexed vertex array. Built once at startup and read-only
+// afterwards, so the render prep thread may read it without locking. Indexes are relative to the
+// mesh's first vertex. Positions are also kept split into x and y arrays, padded per mesh, for
+// TransformInstances.
+//
+class MeshLibrary
+{
+public:
+	MeshLibrary();
+	~MeshLibrary();
+
+	void Startup();
+
+	Vertex_PCU const* GetVerts(unsigned short meshId) const { return &m_verts[m_meshes[meshId].m_firstVert]; }
+	int GetNumVerts(unsigned short meshId) const { return m_meshes[meshId].m_numVerts; }
+	unsigned int const* GetIndexes(unsigned short meshId) const { return &m_indexes[m_meshes[meshId].m_firstIndex]; }
+	int GetNumIndexes(unsigned short meshId) const { return m_meshes[meshId].m_numIndexes; }
+	float const* GetLocalXs(unsigned short meshId) const { return &m_localXs[m_meshes[meshId].m_firstLocal]; }
+	float const* GetLocalYs(unsigned short meshId) const { return &m_localYs[m_meshes[meshId].m_firstLocal]; }
+	unsigned short GetLodMeshId(unsigned short meshId, int lod) const { return m_lodMeshIds[meshId][lod]; }
+
+private:
+	struct MeshRange
+	{
+		int m_firstVert = 0;
+		int m_numVerts = 0;
+		int m_firstIndex = 0;
+		int m_numIndexes = 0;
+		int m_firstLocal = 0;
+	};
+
+	struct FixedMeshVertex
+	{
+		float			m_x;
+		float			m_y;
+		unsigned char	m_r;
+		unsigned char	m_g;
+		unsigned char	m_b;
+		unsigned char	m_a;
+	};
+
+	void AddMesh(unsigned short meshId, Vertex_PCU const* verts, int numVerts, unsigned int const* indexes, int numIndexes);
+	void AddFixedMesh(unsigned short meshId, FixedMeshVertex const* fixedVerts, int numVerts);
+	void AddFanMeshLods(unsigned short meshId, unsigned short firstLodMeshId, Vertex_PCU const* fanVerts, int numRimVerts);
+	void BuildLocalPositions();
+
+private:
+	std::vector<Vertex_PCU> m_verts;
+	std::vector<unsigned int> m_indexes;
+	std::vector<float> m_localXs;
+	std::vector<float> m_localYs;
+	MeshRange m_meshes[NUM_MESH_IDS];
+	unsigned short m_lodMeshIds[NUM_LOD0_MESH_IDS][NUM_MESH_LODS];
+};
@@ -0,0 +1,134 @@
+#include "Game/Minimap.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/SpatialGrid.hpp"
+#include "Game/RenderBackend.hpp"
+
+extern RenderBackend* g_theRenderBackend;
+
+Minimap::Minimap(AABB2 const& screenBounds, Vec2 const& worldSize)
+	: m_screenBounds(screenBounds)
+	, m_worldSize(worldSize)
+{
+	// background, every density cell, and the markers and frames on top
+	m_verts.reserve(6 + 6 * MINIMAP_CELLS_X * MINIMAP_CELLS_Y + 6 * MAX_MINIMAP_MARKERS + 24 * MAX_MINIMAP_VIEW_FRAMES);
+}
+
+//-----------------------------------------------------------------------------------------------
+// Counts down the refresh interval on the game clock, so a paused game keeps its last minimap.
+//
+bool Minimap::IsRefreshDue(float deltaSeconds)
+{
+	m_secondsUntilRefresh -= deltaSeconds;
+	if (m_secondsUntilRefresh > 0.f)
+	{
+		return false;
+	}
+	m_secondsUntilRefresh += MINIMAP_UPDATE_SECONDS;
+	if (m_secondsUntilRefresh < 0.f)
+	{
+		m_secondsUntilRefresh = MINIMAP_UPDATE_SECONDS;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Restarts the vertex array with the background and the enemy density. Walks the grid's cells,
+// not its items, so the cost is fixed by the two grid resolutions.
+//
+void Minimap::BeginRefresh(SpatialGrid const& enemyGrid)
+{
+	m_verts.clear();
+	++m_version;
+	AddVertsForQuad(m_screenBounds.m_mins, m_screenBounds.m_maxs, Rgba8(0, 0, 0, 150));
+
+	for (int cellIndex = 0; cellIndex < MINIMAP_CELLS_X * MINIMAP_CELLS_Y; ++cellIndex)
+	{
+		m_cellCounts[cellIndex] = 0;
+	}
+
+	float cellsPerWorldX = static_cast<float>(MINIMAP_CELLS_X) / m_worldSize.x;
+	float cellsPerWorldY = static_cast<float>(MINIMAP_CELLS_Y) / m_worldSize.y;
+	for (int gridY = 0; gridY < enemyGrid.GetNumCellsY(); ++gridY)
+	{
+		for (int gridX = 0; gridX < enemyGrid.GetNumCellsX(); ++gridX)
+		{
+			int numItems = enemyGrid.GetNumItemsInCell(gridX, gridY);
+			if (numItems == 0)
+			{
+				continue;
+			}
+
+			Vec2 center = enemyGrid.GetCellCenter(gridX, gridY);
+			int cellX = static_cast<int>(center.x * cellsPerWorldX);
+			int cellY = static_cast<int>(center.y * cellsPerWorldY);
+			cellX = cellX < 0 ? 0 : (cellX >= MINIMAP_CELLS_X ? MINIMAP_CELLS_X - 1 : cellX);
+			cellY = cellY < 0 ? 0 : (cellY >= MINIMAP_CELLS_Y ? MINIMAP_CELLS_Y - 1 : cellY);
+			m_cellCounts[cellY * MINIMAP_CELLS_X + cellX] += numItems;
+		}
+	}
+
+	Vec2 screenSize = m_screenBounds.m_maxs - m_screenBounds.m_mins;
+	Vec2 cellSize(screenSize.x / static_cast<float>(MINIMAP_CELLS_X), screenSize.y / static_cast<float>(MINIMAP_CELLS_Y));
+	for (int cellY = 0; cellY < MINIMAP_CELLS_Y; ++cellY)
+	{
+		for (int cellX = 0; cellX < MINIMAP_CELLS_X; ++cellX)
+		{
+			int count = m_cellCounts[cellY * MINIMAP_CELLS_X + cellX];
+			if (count == 0)
+			{
+				continue;
+			}
+
+			float density = count >= MINIMAP_ENTITIES_PER_FULL_CELL ? 1.f : static_cast<float>(count) / static_cast<float>(MINIMAP_ENTITIES_PER_FULL_CELL);
+			unsigned char alpha = static_cast<unsigned char>(80.f + 175.f * density);
+			Vec2 mins(m_screenBounds.m_mins.x + cellSize.x * static_cast<float>(cellX), m_screenBounds.m_mins.y + cellSize.y * static_cast<float>(cellY));
+			AddVertsForQuad(mins, mins + cellSize, Rgba8(255, 80, 40, alpha));
+		}
+	}
+}
+
+void Minimap::AddViewFrame(AABB2 const& worldBounds, Rgba8 const& color)
+{
+	Vec2 mins = GetScreenPosition(worldBounds.m_mins);
+	Vec2 maxs = GetScreenPosition(worldBounds.m_maxs);
+	AddVertsForLine2D(m_verts, Vec2(mins.x, mins.y), Vec2(maxs.x, mins.y), 1.f, color);
+	AddVertsForLine2D(m_verts, Vec2(maxs.x, mins.y), Vec2(maxs.x, maxs.y), 1.f, color);
+	AddVertsForLine2D(m_verts, Vec2(maxs.x, maxs.y), Vec2(mins.x, maxs.y), 1.f, color);
+	AddVertsForLine2D(m_verts, Vec2(mins.x, maxs.y), Vec2(mins.x, mins.y), 1.f, color);
+}
+
+void Minimap::AddMarker(Vec2 const& worldPosition, Rgba8 const& color)
+{
+	Vec2 center = GetScreenPosition(worldPosition);
+	Vec2 halfSize(0.5f * MINIMAP_MARKER_SIZE, 0.5f * MINIMAP_MARKER_SIZE);
+	AddVertsForQuad(center - halfSize, center + halfSize, color);
+}
+
+void Minimap::Render() const
+{
+	if (m_verts.empty())
+	{
+		return;
+	}
+
+	g_theRenderBackend->BindTexture(nullptr);
+	g_theRenderBackend->DrawVertexArray(static_cast<int>(m_verts.size()), m_verts.data());
+}
+
+Vec2 Minimap::GetScreenPosition(Vec2 const& worldPosition) const
+{
+	Vec2 screenSize = m_screenBounds.m_maxs - m_screenBounds.m_mins;
+	return Vec2(m_screenBounds.m_mins.x + screenSize.x * worldPosition.x / m_worldSize.x,
+				m_screenBounds.m_mins.y + screenSize.y * worldPosition.y / m_worldSize.y);
+}
+
+void Minimap::AddVertsForQuad(Vec2 const& mins, Vec2 const& maxs, Rgba8 const& color)
+{
+	m_verts.emplace_back(Vec3(mins.x, mins.y, 0.f), color, Vec2(0.f, 0.f));
+	m_verts.emplace_back(Vec3(maxs.x, mins.y, 0.f), color, Vec2(0.f, 0.f));
+	m_verts.emplace_back(Vec3(maxs.x, maxs.y, 0.f), color, Vec2(0.f, 0.f));
+
+	m_verts.emplace_back(Vec3(mins.x, mins.y, 0.f), color, Vec2(0.f, 0.f));
+	m_verts.emplace_back(Vec3(maxs.x, maxs.y, 0.f), color, Vec2(0.f, 0.f));
+	m_verts.emplace_back(Vec3(mins.x, maxs.y, 0.f), color, Vec2(0.f, 0.f));
+}
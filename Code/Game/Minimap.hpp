@@ -0,0 +1,51 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include <vector>
+
+class SpatialGrid;
+
+constexpr int MINIMAP_CELLS_X = 40;
+constexpr int MINIMAP_CELLS_Y = 20;
+constexpr int MINIMAP_ENTITIES_PER_FULL_CELL = 6;		// a cell holding this many enemies or more draws at full density
+constexpr float MINIMAP_UPDATE_SECONDS = 0.1f;
+constexpr float MINIMAP_MARKER_SIZE = 4.f;				// in screen units
+constexpr int MAX_MINIMAP_MARKERS = 8;
+constexpr int MAX_MINIMAP_VIEW_FRAMES = 8;
+
+//-----------------------------------------------------------------------------------------------
+// The whole world in a small screen rectangle. Enemies are not drawn one by one: the counts of
+// the enemy broadphase grid are summed into MINIMAP_CELLS_X by MINIMAP_CELLS_Y density cells, one
+// quad per occupied cell. Markers (ships) and view frames (what each camera sees) are added on
+// top. The vertex array has a fixed upper bound that does not depend on the entity count, and it
+// is rebuilt only every MINIMAP_UPDATE_SECONDS; in between Render redraws the last one.
+//
+class Minimap
+{
+public:
+	Minimap(AABB2 const& screenBounds, Vec2 const& worldSize);
+
+	bool IsRefreshDue(float deltaSeconds);
+	void BeginRefresh(SpatialGrid const& enemyGrid);
+	void AddViewFrame(AABB2 const& worldBounds, Rgba8 const& color);
+	void AddMarker(Vec2 const& worldPosition, Rgba8 const& color);
+
+	void Render() const;
+
+	int GetNumVerts() const { return static_cast<int>(m_verts.size()); }
+	unsigned int GetVersion() const { return m_version; }	// changes on every refresh
+
+private:
+	Vec2 GetScreenPosition(Vec2 const& worldPosition) const;
+	void AddVertsForQuad(Vec2 const& mins, Vec2 const& maxs, Rgba8 const& color);
+
+private:
+	AABB2					m_screenBounds;
+	Vec2					m_worldSize;
+	float					m_secondsUntilRefresh = 0.f;
+	int						m_cellCounts[MINIMAP_CELLS_X * MINIMAP_CELLS_Y] = {};
+	std::vector<Vertex_PCU>	m_verts;
+	unsigned int			m_version = 0;
+};
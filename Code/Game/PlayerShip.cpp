@@ -1,4 +1,7 @@
 ﻿#include "Game/PlayerShip.hpp"
+#include "Game/DebugDrawBatch.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/MeshLibrary.hpp"
 #include "Game/App.hpp"
 #include "Game/GameCommon.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
@@ -6,26 +9,32 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Input/InputSystem.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
 #include <math.h>
 
 extern App* g_theApp;
 extern Renderer* g_theRenderer;
 extern InputSystem* g_theInput;
-extern AudioSystem* g_theAudio;
+
 RandomNumberGenerator m_rng;
 
 
-PlayerShip::PlayerShip(Game* owner, Vec2 const& pos, float orientationDeg, Rgba8 color, bool isSecondary)
-	: Entity(owner, pos, orientationDeg, color)
+//-----------------------------------------------------------------------------------------------
+// Players start around the world center facing it: left, right, bottom, top.
+//
+static Vec2 const s_playerStartOffsets[MAX_PLAYERS] = { Vec2(-50.f, 0.f), Vec2(50.f, 0.f), Vec2(0.f, -50.f), Vec2(0.f, 50.f) };
+static float const s_playerStartOrientations[MAX_PLAYERS] = { 0.f, 180.f, 90.f, 270.f };
+static Rgba8 const s_playerColors[MAX_PLAYERS] = { Rgba8(102, 153, 204, 255), Rgba8(153, 0, 0, 255), Rgba8(0, 153, 76, 255), Rgba8(204, 153, 0, 255) };
+
+PlayerShip::PlayerShip(Game* owner, int playerIndex)
+	: Entity(owner, GetStartPosition(playerIndex), GetStartOrientationDegrees(playerIndex), GetPlayerColor(playerIndex))
 {
-	InitializeVerts(&m_localVerts[0], m_color);
 	m_velocity = Vec2(0.f, 0.f);
 	m_physicsRadius = PLAYER_SHIP_PHYSICS_RADIUS;
 	m_cosmeticRadius = PLAYER_SHIP_COSMETIC_RADIUS;
 	m_health = 1;
+	m_meshId = MESH_SHIP;
 
-	m_isSecondary = isSecondary;
+	m_playerIndex = playerIndex;
 }
 
 PlayerShip::~PlayerShip()
@@ -43,26 +52,28 @@ void PlayerShip::Update(float deltaSeconds)
 	
 }
 
-void PlayerShip::Render() const
+void PlayerShip::ExtractRenderProxies(RenderSnapshot& snapshot) const
 {
-	RenderTail();
-	RenderShip();
-	RenderSkillBar();
+	ExtractTail(snapshot);
+	ExtractShip(snapshot);
+	ExtractSkillBar(snapshot);
 }
 
 void PlayerShip::UpdateFromPlayers(float deltaSeconds)
 {
 
-	if (!m_game->m_multiplayer)
+	// alone, the keyboard and the first controller both fly the ship; otherwise player 0 has the
+	// keyboard and player N the Nth controller
+	if (m_game->m_numPlayers == 1)
 	{
 		UpdateFromKeyboard(deltaSeconds);
-		UpdateFromController(deltaSeconds);
+		UpdateFromController(deltaSeconds, 0);
 	}
 	else
 	{
-		if (m_isSecondary)
+		if (m_playerIndex > 0)
 		{
-			UpdateFromController(deltaSeconds);
+			UpdateFromController(deltaSeconds, m_playerIndex - 1);
 		}
 		else
 		{
@@ -95,33 +106,25 @@ void PlayerShip::UpdateSkillInvisible(float deltaSeconds)
 }
 
 
-void PlayerShip::RenderShip() const
+void PlayerShip::ExtractShip(RenderSnapshot& snapshot) const
 {
-	Vertex_PCU worldSpaceVerts[NUM_SHIP_VERTS];
-
-	for (int vertIndex = 0; vertIndex < NUM_SHIP_VERTS; ++vertIndex)
+	float blink = m_invisibleTimer;
+	float alpha;
+	if (blink < 1.5f)
 	{
-		worldSpaceVerts[vertIndex] = m_localVerts[vertIndex];
-		float blink = m_invisibleTimer;
-		float alpha;
-		if (blink < 1.5f)
-		{
-			alpha = RangeMapClamped(blink, 0.f, 1.5f, 255.f, 0.f);
-		}
-		else
-		{
-			alpha = RangeMapClamped(blink, 1.5f, 3.0f, 0.f, 255.f);
-		}
-		Rgba8 colorNow = m_color;
-		colorNow.a = static_cast<unsigned char> (alpha);
-		worldSpaceVerts[vertIndex].m_color = colorNow;
-
+		alpha = RangeMapClamped(blink, 0.f, 1.5f, 255.f, 0.f);
 	}
-	TransformVertexArrayXY3D(NUM_SHIP_VERTS, &worldSpaceVerts[0], 1.f, m_orientationDegrees, m_position);
-	g_theRenderer->DrawVertexArray(NUM_SHIP_VERTS, &worldSpaceVerts[0]);
+	else
+	{
+		alpha = RangeMapClamped(blink, 1.5f, 3.0f, 0.f, 255.f);
+	}
+	Rgba8 colorNow = m_color;
+	colorNow.a = static_cast<unsigned char> (alpha);
+
+	snapshot.AddProxy(m_meshId, LAYER_SHIPS, m_position, m_orientationDegrees, colorNow);
 }
 
-void PlayerShip::RenderSkillBar() const
+void PlayerShip::ExtractSkillBar(RenderSnapshot& snapshot) const
 {
 	if (!m_isInvisible)
 	{
@@ -137,7 +140,7 @@ void PlayerShip::RenderSkillBar() const
 		{
 			skillInviColor = Rgba8(192, 192, 192, 192);
 		}
-		DebugDrawLine(Vec2(m_position.x - 2.f, m_position.y - 3.5f), Vec2(m_position.x - 2.f + (GetClamped(m_invisibleCooldown, 0.f, 10.f) * 0.4f), m_position.y - 3.5f), 0.5f, skillInviColor);
+		snapshot.AddLine(LAYER_SHIPS, Vec2(m_position.x - 2.f, m_position.y - 3.5f), Vec2(m_position.x - 2.f + (GetClamped(m_invisibleCooldown, 0.f, 10.f) * 0.4f), m_position.y - 3.5f), 0.5f, skillInviColor);
 		
 		if (GetClamped(m_specialAttackCooldownA, 0.f, 1.f) >= 1.f)
 		{
@@ -147,7 +150,7 @@ void PlayerShip::RenderSkillBar() const
 		{
 			skillBulletColorA = Rgba8(192, 192, 192, 192);
 		}
-		DebugDrawLine(Vec2(m_position.x - 2.f, m_position.y - 4.5f), Vec2(m_position.x - 2.f + (GetClamped(m_specialAttackCooldownA, 0.f, 1.f) * 4), m_position.y - 4.5f), 0.4f, skillBulletColorA);
+		snapshot.AddLine(LAYER_SHIPS, Vec2(m_position.x - 2.f, m_position.y - 4.5f), Vec2(m_position.x - 2.f + (GetClamped(m_specialAttackCooldownA, 0.f, 1.f) * 4), m_position.y - 4.5f), 0.4f, skillBulletColorA);
 
 
 		if (GetClamped(m_specialAttackCooldownB, 0.f, 2.f) >= 2.f)
@@ -158,7 +161,7 @@ void PlayerShip::RenderSkillBar() const
 		{
 			skillBulletColorB = Rgba8(192, 192, 192, 192);
 		}
-		DebugDrawLine(Vec2(m_position.x - 2.f, m_position.y - 5.5f), Vec2(m_position.x - 2.f + (GetClamped(m_specialAttackCooldownB, 0.f, 2.f) * 2), m_position.y - 5.5f), 0.4f, skillBulletColorB);
+		snapshot.AddLine(LAYER_SHIPS, Vec2(m_position.x - 2.f, m_position.y - 5.5f), Vec2(m_position.x - 2.f + (GetClamped(m_specialAttackCooldownB, 0.f, 2.f) * 2), m_position.y - 5.5f), 0.4f, skillBulletColorB);
 	}
 
 	
@@ -167,98 +170,48 @@ void PlayerShip::RenderSkillBar() const
 
 }
 
-void PlayerShip::DebugRender() const
+void PlayerShip::ExtractDebugShapes(DebugShapeList& debugShapes) const
 {
-	DebugDrawRing(m_position, m_physicsRadius, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 255, 255));
-	DebugDrawRing(m_position, m_cosmeticRadius, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 255, 255));
+	debugShapes.AddRing(m_position, m_physicsRadius, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 255, 255));
+	debugShapes.AddRing(m_position, m_cosmeticRadius, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 255, 255));
 
 	Vec2 fwdCartPos = Vec2::MakeFromPolarDegrees(m_orientationDegrees, m_cosmeticRadius);
 	Vec2 fwdPos = Vec2(m_position.x + fwdCartPos.x, m_position.y + fwdCartPos.y);
-	DebugDrawLine(m_position, fwdPos, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 0, 255));
+	debugShapes.AddLine(m_position, fwdPos, DEBUG_LINE_THICKNESS, Rgba8(255, 0, 0, 255));
 
 	Vec2 leftCartPos = Vec2::MakeFromPolarDegrees(m_orientationDegrees + 90.f, m_cosmeticRadius);
 	Vec2 leftPos = Vec2(m_position.x + leftCartPos.x, m_position.y + leftCartPos.y);
-	DebugDrawLine(m_position, leftPos, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 0, 255));
+	debugShapes.AddLine(m_position, leftPos, DEBUG_LINE_THICKNESS, Rgba8(0, 255, 0, 255));
 
 	Vec2 velCartPos = Vec2::MakeFromPolarDegrees(Atan2Degrees(m_velocity.y, m_velocity.x), m_velocity.GetLength());
 	Vec2 velPos = Vec2(m_position.x + velCartPos.x, m_position.y + velCartPos.y);
-	DebugDrawLine(m_position, velPos, DEBUG_LINE_THICKNESS, Rgba8(255, 255, 0, 255));
+	debugShapes.AddLine(m_position, velPos, DEBUG_LINE_THICKNESS, Rgba8(255, 255, 0, 255));
 	
 	
 }
 
-void PlayerShip::RenderTail() const
+void PlayerShip::ExtractTail(RenderSnapshot& snapshot) const
 {
-	Vec2 shipDirection = GetForwardNormal();
-	Vec2 tailPosition = m_position - shipDirection * 2.f;
-
-	Vec2 flameTip = tailPosition - shipDirection * m_flameLength;
-	Vec2 leftBase = tailPosition + Vec2(-shipDirection.y, shipDirection.x);
-	Vec2 rightBase = tailPosition + Vec2(shipDirection.y, -shipDirection.x);
-
-	Vertex_PCU tailVertex[3];
-	tailVertex[0].m_position = Vec3(flameTip.x, flameTip.y, 0.f);
-	tailVertex[2].m_position = Vec3(leftBase.x, leftBase.y, 0.f);
-	tailVertex[1].m_position = Vec3(rightBase.x, rightBase.y, 0.f);
+	Vec2 tailPosition = m_position - GetForwardNormal() * 2.f;
 
 	Rgba8 colorNow = m_flameColor;
 	colorNow.a = static_cast<unsigned char> (m_flameCurrentAlpha);
-	tailVertex[0].m_color = colorNow;
-	tailVertex[2].m_color = colorNow;
-	tailVertex[1].m_color = colorNow;
 
-	g_theRenderer->DrawVertexArray(3, &tailVertex[0]);
-	
+	RenderProxy& proxy = snapshot.AddProxy(MESH_FLAME, LAYER_SHIPS, tailPosition, m_orientationDegrees, colorNow);
+	proxy.m_scale = Vec2(m_flameLength, 1.f);
 }
 
 
 void PlayerShip::Die()
 {
 	m_isDead = true;
+	GameCommandBuffer& commands = m_game->GetCommandBuffer();
 	if (m_extraLives != 0)
 	{
-		SoundID die = g_theAudio->CreateOrGetSound("Data/Audio/ShipDie.wav");
-		g_theAudio->StartSound(die, false, 0.01f);
-	}
-	m_game->AddCameraShakeTrauma(1.5f, m_isSecondary);
-	m_game->SpawnNewDebrisCluster(20, m_position, m_velocity, 10.f, m_physicsRadius * DEBRIS_SCALE, m_originalColor);
-}
-
-void PlayerShip::InitializeVerts(Vertex_PCU* vertsToFillIn, Rgba8 color)
-{
-	//left wing(A)
-	vertsToFillIn[0].m_position	= Vec3(2.f, 1.f, 0.f);
-	vertsToFillIn[1].m_position	= Vec3(0.f, 2.f, 0.f);
-	vertsToFillIn[2].m_position	= Vec3(-2.f, 1.f, 0.f);
-	
-
-	//half main(B)
-	vertsToFillIn[3].m_position	= Vec3(0.f, 1.f, 0.f);
-	vertsToFillIn[4].m_position	= Vec3(-2.f, 1.f, 0.f);
-	vertsToFillIn[5].m_position	= Vec3(-2.f, -1.f, 0.f);
-	
-
-	//half main(C)
-	vertsToFillIn[6].m_position	= Vec3(0.f, 1.f, 0.f);
-	vertsToFillIn[7].m_position	= Vec3(-2.f, -1.f, 0.f);
-	vertsToFillIn[8].m_position	= Vec3(0.f, -1.f, 0.f);
-	
-
-	//nose(D)
-	vertsToFillIn[9].m_position	= Vec3(1.f, 0.f, 0.f);
-	vertsToFillIn[10].m_position = Vec3(0.f, 1.f, 0.f);
-	vertsToFillIn[11].m_position = Vec3(0.f, -1.f, 0.f);
-	
-
-	//right wing(E)
-	vertsToFillIn[12].m_position = Vec3(2.f, -1.f, 0.f);
-	vertsToFillIn[13].m_position = Vec3(-2.f, -1.f, 0.f);
-	vertsToFillIn[14].m_position = Vec3(0.f, -2.f, 0.f);
-	
-	for (int i = 0; i < NUM_SHIP_VERTS; ++i)
-	{
-		vertsToFillIn[i].m_color = color;
+		commands.PlaySound(SOUND_SHIP_DIE, 0.01f);
 	}
+	commands.AddCameraShake(1.5f, m_playerIndex);
+	commands.SpawnDebrisCluster(20, m_position, m_velocity, 10.f, m_physicsRadius * DEBRIS_SCALE, m_originalColor);
 }
 
 void PlayerShip::UpdateFromKeyboard(float deltaSeconds)
@@ -303,11 +256,11 @@ void PlayerShip::UpdateFromKeyboard(float deltaSeconds)
 				Vec2 bulletRelativeVelocity = forwardNormal * BULLET_SPEED;
 				
 				Vec2 bulletVelocity = shipVelocity + bulletRelativeVelocity;
-				m_game->SpawnBullet(nosePosition, m_orientationDegrees, bulletVelocity);
+				GameCommandBuffer& commands = m_game->GetCommandBuffer();
+				commands.SpawnBullet(nosePosition, m_orientationDegrees, bulletVelocity);
 
 				m_fireTimer = 0.0f;
-				SoundID shootSound = g_theAudio->CreateOrGetSound("Data/Audio/Shoot.wav");
-				g_theAudio->StartSound(shootSound, false, 0.5f);
+				commands.PlaySound(SOUND_SHOOT, 0.5f);
 			}
 			
 		}
@@ -317,8 +270,7 @@ void PlayerShip::UpdateFromKeyboard(float deltaSeconds)
 			m_isInvisible = true;
 			m_invisibleTimer = 0.0f;
 			m_invisibleCooldown = 0.0f;
-			SoundID skillInvi = g_theAudio->CreateOrGetSound("Data/Audio/SkillInvi.wav");
-			g_theAudio->StartSound(skillInvi, false, .1f);
+			m_game->GetCommandBuffer().PlaySound(SOUND_SKILL_INVINCIBLE, .1f);
 		}
 
 		if (g_theInput->WasKeyJustPressed('K') && m_specialAttackCooldownA >= 1.f)
@@ -328,9 +280,9 @@ void PlayerShip::UpdateFromKeyboard(float deltaSeconds)
 				m_specialAttackCooldownA = 0.0f;
 				Vec2 forwardNormal = GetForwardNormal();
 				Vec2 nosePosition = m_position + (forwardNormal * 1.f);
-				m_game->SpawnBullets(nosePosition, m_orientationDegrees, m_velocity, 12, 60.f);
-				SoundID skillBullets = g_theAudio->CreateOrGetSound("Data/Audio/SkillBullets.wav");
-				g_theAudio->StartSound(skillBullets, false, .1f);
+				GameCommandBuffer& commands = m_game->GetCommandBuffer();
+				commands.SpawnBulletSpread(nosePosition, m_orientationDegrees, m_velocity, 12, 60.f);
+				commands.PlaySound(SOUND_SKILL_BULLETS, .1f);
 			}
 		}
 
@@ -341,9 +293,9 @@ void PlayerShip::UpdateFromKeyboard(float deltaSeconds)
 				m_specialAttackCooldownB = 0.0f;
 				Vec2 forwardNormal = GetForwardNormal();
 				Vec2 nosePosition = m_position + (forwardNormal * 1.f);
-				m_game->SpawnBullets(nosePosition, m_orientationDegrees, m_velocity, 36, 360.f);
-				SoundID skillBullets = g_theAudio->CreateOrGetSound("Data/Audio/SkillBullets.wav");
-				g_theAudio->StartSound(skillBullets, false, .1f);
+				GameCommandBuffer& commands = m_game->GetCommandBuffer();
+				commands.SpawnBulletSpread(nosePosition, m_orientationDegrees, m_velocity, 36, 360.f);
+				commands.PlaySound(SOUND_SKILL_BULLETS, .1f);
 			}
 		}
 	} 
@@ -358,12 +310,12 @@ void PlayerShip::UpdateFromKeyboard(float deltaSeconds)
 
 }
 
-void PlayerShip::UpdateFromController(float deltaSeconds)
+void PlayerShip::UpdateFromController(float deltaSeconds, int controllerIndex)
 {
 
-	XboxController const& controller = g_theInput->GetController(0);
+	XboxController const& controller = g_theInput->GetController(controllerIndex);
 
-	if (IsAlive() && !m_game->m_multiplayer)
+	if (IsAlive())
 	{
 		float leftStickMagnitude = controller.GetLeftStick().GetMagnitude();
 		if (leftStickMagnitude > 0.f)
@@ -389,11 +341,11 @@ void PlayerShip::UpdateFromController(float deltaSeconds)
 				Vec2 bulletRelativeVelocity = forwardNormal * BULLET_SPEED;
 
 				Vec2 bulletVelocity = shipVelocity + bulletRelativeVelocity;
-				m_game->SpawnBullet(nosePosition, m_orientationDegrees, bulletVelocity);
+				GameCommandBuffer& commands = m_game->GetCommandBuffer();
+				commands.SpawnBullet(nosePosition, m_orientationDegrees, bulletVelocity);
 
 				m_fireTimer = 0.0f;
-				SoundID shootSound = g_theAudio->CreateOrGetSound("Data/Audio/Shoot.wav");
-				g_theAudio->StartSound(shootSound, false, 0.5f);
+				commands.PlaySound(SOUND_SHOOT, 0.5f);
 			}
 			
 		}
@@ -402,8 +354,7 @@ void PlayerShip::UpdateFromController(float deltaSeconds)
 		{
 			m_isInvisible = true;
 			m_invisibleTimer = 0.0f;
-			SoundID skillInvi = g_theAudio->CreateOrGetSound("Data/Audio/SkillInvi.wav");
-			g_theAudio->StartSound(skillInvi, false, .1f);
+			m_game->GetCommandBuffer().PlaySound(SOUND_SKILL_INVINCIBLE, .1f);
 		}
 		if (controller.WasButtonJustPressed(XboxButtonID::XBOX_BUTTON_B) && m_specialAttackCooldownA >= 1.f)
 		{
@@ -412,9 +363,9 @@ void PlayerShip::UpdateFromController(float deltaSeconds)
 				m_specialAttackCooldownA = 0.0f;
 				Vec2 forwardNormal = GetForwardNormal();
 				Vec2 nosePosition = m_position + (forwardNormal * 1.f);
-				m_game->SpawnBullets(nosePosition, m_orientationDegrees, m_velocity, 12, 60.f);
-				SoundID skillBullets = g_theAudio->CreateOrGetSound("Data/Audio/SkillBullets.wav");
-				g_theAudio->StartSound(skillBullets, false, .5f);
+				GameCommandBuffer& commands = m_game->GetCommandBuffer();
+				commands.SpawnBulletSpread(nosePosition, m_orientationDegrees, m_velocity, 12, 60.f);
+				commands.PlaySound(SOUND_SKILL_BULLETS, .5f);
 			}
 		}
 
@@ -425,9 +376,9 @@ void PlayerShip::UpdateFromController(float deltaSeconds)
 				m_specialAttackCooldownB = 0.0f;
 				Vec2 forwardNormal = GetForwardNormal();
 				Vec2 nosePosition = m_position + (forwardNormal * 1.f);
-				m_game->SpawnBullets(nosePosition, m_orientationDegrees, m_velocity, 36, 360.f);
-				SoundID skillBullets = g_theAudio->CreateOrGetSound("Data/Audio/SkillBullets.wav");
-				g_theAudio->StartSound(skillBullets, false, .5f);
+				GameCommandBuffer& commands = m_game->GetCommandBuffer();
+				commands.SpawnBulletSpread(nosePosition, m_orientationDegrees, m_velocity, 36, 360.f);
+				commands.PlaySound(SOUND_SKILL_BULLETS, .5f);
 			}
 		}
 
@@ -477,8 +428,7 @@ void PlayerShip::BounceOffWalls()
 		m_velocity.x *= -1.f;
 		if (!m_isInvisible && !m_isDead)
 		{
-			SoundID collision = g_theAudio->CreateOrGetSound("Data/Audio/Collision.wav");
-			g_theAudio->StartSound(collision, false, 0.005f);
+			m_game->GetCommandBuffer().PlaySound(SOUND_COLLISION, 0.005f);
 		}
 		
 	}
@@ -489,8 +439,7 @@ void PlayerShip::BounceOffWalls()
 		m_velocity.x *= -1.f;
 		if (!m_isInvisible && !m_isDead)
 		{
-			SoundID collision = g_theAudio->CreateOrGetSound("Data/Audio/Collision.wav");
-			g_theAudio->StartSound(collision, false, 0.005f);
+			m_game->GetCommandBuffer().PlaySound(SOUND_COLLISION, 0.005f);
 		}
 	}
 
@@ -500,8 +449,7 @@ void PlayerShip::BounceOffWalls()
 		m_velocity.y *= -1.f;
 		if (!m_isInvisible && !m_isDead)
 		{
-			SoundID collision = g_theAudio->CreateOrGetSound("Data/Audio/Collision.wav");
-			g_theAudio->StartSound(collision, false, 0.005f);
+			m_game->GetCommandBuffer().PlaySound(SOUND_COLLISION, 0.005f);
 		}
 	}
 
@@ -511,8 +459,7 @@ void PlayerShip::BounceOffWalls()
 		m_velocity.y *= -1.f;
 		if (!m_isInvisible && !m_isDead)
 		{
-			SoundID collision = g_theAudio->CreateOrGetSound("Data/Audio/Collision.wav");
-			g_theAudio->StartSound(collision, false, 0.005f);
+			m_game->GetCommandBuffer().PlaySound(SOUND_COLLISION, 0.005f);
 		}
 	}
 }
@@ -520,33 +467,22 @@ void PlayerShip::BounceOffWalls()
 void PlayerShip::ShipsCollision()
 {
 	m_velocity *= -1.f;
-	SoundID collision = g_theAudio->CreateOrGetSound("Data/Audio/Collision.wav");
-	g_theAudio->StartSound(collision, false, 0.005f);
+	m_game->GetCommandBuffer().PlaySound(SOUND_COLLISION, 0.005f);
 }
 
 
 
 void PlayerShip::Respawn()
 {
-	if (!m_isSecondary)
-	{
-		m_position = Vec2(WORLD_CENTER_X - 50.f, WORLD_CENTER_Y);
-		m_orientationDegrees = 0.0f;
-	}
-	else
-	{
-		m_position = Vec2(WORLD_CENTER_X + 50.f, WORLD_CENTER_Y);
-		m_orientationDegrees = 180.0f;
-	}
-	
-	
+	m_position = GetStartPosition(m_playerIndex);
+	m_orientationDegrees = GetStartOrientationDegrees(m_playerIndex);
+
 	m_velocity = Vec2(0.0f, 0.0f);
 	m_isDead = false;
 	m_health = 1;
 	m_extraLives -= 1;
 	m_isInvisible = true;
-	SoundID respawn = g_theAudio->CreateOrGetSound("Data/Audio/ShipRespawn.wav");
-	g_theAudio->StartSound(respawn, false, 0.1f);
+	m_game->GetCommandBuffer().PlaySound(SOUND_SHIP_RESPAWN, 0.1f);
 }
 
 Vec2 PlayerShip::GetPosition()
@@ -554,4 +490,19 @@ Vec2 PlayerShip::GetPosition()
 	return m_position;
 }
 
+Vec2 PlayerShip::GetStartPosition(int playerIndex)
+{
+	return Vec2(WORLD_CENTER_X, WORLD_CENTER_Y) + s_playerStartOffsets[playerIndex];
+}
+
+float PlayerShip::GetStartOrientationDegrees(int playerIndex)
+{
+	return s_playerStartOrientations[playerIndex];
+}
+
+Rgba8 PlayerShip::GetPlayerColor(int playerIndex)
+{
+	return s_playerColors[playerIndex];
+}
+
 
@@ -12,24 +12,28 @@ constexpr int NUM_SHIP_VERTS = 3 * NUM_SHIP_TRIS;
 class PlayerShip : public Entity
 {
 public:
-    PlayerShip(Game* game, const Vec2& startPos, float orientationDeg, Rgba8 color, bool isSecondary);
+    PlayerShip(Game* game, int playerIndex);
     ~PlayerShip();
 
     virtual void Update(float deltaSeconds) override;
-    virtual void Render() const override;
-    virtual void DebugRender() const override;
-    void RenderTail() const;
-    void RenderShip() const;
-    void RenderSkillBar() const;
+    virtual void ExtractRenderProxies(RenderSnapshot& snapshot) const override;
+    virtual void ExtractDebugShapes(DebugShapeList& debugShapes) const override;
+    void ExtractTail(RenderSnapshot& snapshot) const;
+    void ExtractShip(RenderSnapshot& snapshot) const;
+    void ExtractSkillBar(RenderSnapshot& snapshot) const;
     virtual void Die() override;
     void Respawn();
     Vec2 GetPosition();
-    static void InitializeVerts(Vertex_PCU* vertsToFillIn, Rgba8 color);
     int GetExtraLives() { return m_extraLives; }
     float GetOrientionDegrees() { return m_orientationDegrees; }
     void UpdateSkillInvisible(float deltaSeconds);
     void UpdateFromPlayers(float deltaSeconds);
     void ShipsCollision();
+    int GetPlayerIndex() const { return m_playerIndex; }
+
+    static Vec2 GetStartPosition(int playerIndex);
+    static float GetStartOrientationDegrees(int playerIndex);
+    static Rgba8 GetPlayerColor(int playerIndex);
 
     float m_invisibleTimer = 0.f;
     bool m_isInvisible = false;
@@ -38,20 +42,19 @@ public:
 private:
     
     void UpdateFromKeyboard(float deltaSeconds);
-    void UpdateFromController(float deltaSeconds);
+    void UpdateFromController(float deltaSeconds, int controllerIndex);
     void UpdateTail(float deltaSeconds);
     void BounceOffWalls();
     
     
 
 private:
-    Vertex_PCU  m_localVerts[NUM_SHIP_VERTS];
     int m_extraLives = 3;
     float m_thrustFraction;
     float m_fireTimer = -.1f;
     float m_specialAttackCooldownA = 2.f;
     float m_specialAttackCooldownB = 5.f;
-    bool m_isSecondary;
+    int m_playerIndex = 0;
     Rgba8 m_flameColor;
     float m_flameLength;
     float m_flameCurrentAlpha;
@@ -0,0 +1,100 @@
+#include "Game/QualityGovernor.hpp"
+
+static QualitySettings const s_qualityLevels[NUM_QUALITY_LEVELS] =
+{
+	// debris	stars	LOD		debug	health bars
+	{ 1.f,		8,		1.f,	1.f,	true },
+	{ 0.75f,	6,		0.8f,	0.75f,	true },
+	{ 0.5f,		4,		0.6f,	0.5f,	true },
+	{ 0.35f,	3,		0.45f,	0.35f,	false },
+	{ 0.25f,	2,		0.3f,	0.25f,	false },
+};
+
+void QualityGovernor::SetForcedLevel(int level)
+{
+	if (level < 0)
+	{
+		m_isForced = false;
+		return;
+	}
+
+	m_isForced = true;
+	ChangeLevel(level < NUM_QUALITY_LEVELS ? level : NUM_QUALITY_LEVELS - 1, QUALITY_FORCED);
+}
+
+void QualityGovernor::AddFrame(double workSeconds, double frameSeconds)
+{
+	m_smoothedWorkSeconds = m_numFrames == 0 ? workSeconds : m_smoothedWorkSeconds + QUALITY_FRAME_SMOOTHING * (workSeconds - m_smoothedWorkSeconds);
+	++m_numFrames;
+	m_secondsAtLevel[m_level] += frameSeconds;
+	if (workSeconds > m_budgetSeconds)
+	{
+		++m_numFramesOverBudget;
+	}
+	if (m_isForced)
+	{
+		return;
+	}
+
+	if (m_smoothedWorkSeconds > m_budgetSeconds)
+	{
+		m_overBudgetSeconds += frameSeconds;
+		m_underBudgetSeconds = 0.0;
+	}
+	else if (m_smoothedWorkSeconds < m_budgetSeconds * QUALITY_RAISE_BUDGET_FRACTION)
+	{
+		m_underBudgetSeconds += frameSeconds;
+		m_overBudgetSeconds = 0.0;
+	}
+	else
+	{
+		m_overBudgetSeconds = 0.0;
+		m_underBudgetSeconds = 0.0;
+	}
+
+	if (m_overBudgetSeconds >= QUALITY_LOWER_HOLD_SECONDS && m_level < NUM_QUALITY_LEVELS - 1)
+	{
+		ChangeLevel(m_level + 1, QUALITY_LOWERED_OVER_BUDGET);
+	}
+	else if (m_underBudgetSeconds >= QUALITY_RAISE_HOLD_SECONDS && m_level > 0)
+	{
+		ChangeLevel(m_level - 1, QUALITY_RAISED_UNDER_BUDGET);
+	}
+}
+
+QualitySettings const& QualityGovernor::GetSettings() const
+{
+	return s_qualityLevels[m_level];
+}
+
+char const* QualityGovernor::GetReasonName(QualityChangeReason reason)
+{
+	switch (reason)
+	{
+	case QUALITY_LOWERED_OVER_BUDGET:	return "lowered, over budget";
+	case QUALITY_RAISED_UNDER_BUDGET:	return "raised, under budget";
+	case QUALITY_FORCED:				return "forced";
+	default:							return "never changed";
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Both hold timers restart, so the next move is judged on frames drawn at the new level.
+//
+void QualityGovernor::ChangeLevel(int level, QualityChangeReason reason)
+{
+	if (level > m_level)
+	{
+		++m_numLowerings;
+	}
+	else if (level < m_level)
+	{
+		++m_numRaisings;
+	}
+	m_level = level;
+	m_overBudgetSeconds = 0.0;
+	m_underBudgetSeconds = 0.0;
+	m_lastChangeReason = reason;
+	m_lastChangeFrame = m_numFrames;
+	m_lastChangeWorkSeconds = m_smoothedWorkSeconds;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+constexpr int NUM_QUALITY_LEVELS = 5;					// level 0 is full quality; each level up sheds more
+constexpr double QUALITY_DEFAULT_FRAME_BUDGET_SECONDS = 1.0 / 60.0;
+constexpr double QUALITY_FRAME_SMOOTHING = 0.1;			// weight of the newest frame in the smoothed work time
+constexpr double QUALITY_RAISE_BUDGET_FRACTION = 0.75;	// smoothed work below this part of the budget earns detail back
+constexpr double QUALITY_LOWER_HOLD_SECONDS = 0.25;
+constexpr double QUALITY_RAISE_HOLD_SECONDS = 2.0;
+
+//-----------------------------------------------------------------------------------------------
+// Cosmetic detail at one quality level. None of it feeds back into the simulation.
+//
+struct QualitySettings
+{
+	float	m_debrisFraction;		// of each debris cluster that is spawned
+	int		m_starsPerTile;
+	float	m_lodPixelScale;		// on-screen radius the mesh LOD choice sees, as a fraction of the real one
+	float	m_debugDetailScale;		// of the on-screen size debug rings pick their side count by
+	bool	m_showHealthBars;
+};
+
+enum QualityChangeReason
+{
+	QUALITY_NOT_CHANGED,
+	QUALITY_LOWERED_OVER_BUDGET,
+	QUALITY_RAISED_UNDER_BUDGET,
+	QUALITY_FORCED
+};
+
+//-----------------------------------------------------------------------------------------------
+// Sheds cosmetic work when frames run over budget and restores it when there is room again.
+//
+// Fed the CPU work time of every frame (not the time spent waiting for the frame pacer), it keeps
+// an exponentially smoothed average. Once that stays over budget for QUALITY_LOWER_HOLD_SECONDS
+// the level goes up by one; once it stays under QUALITY_RAISE_BUDGET_FRACTION of the budget for
+// the longer QUALITY_RAISE_HOLD_SECONDS it comes back down by one. The gap between the two
+// thresholds and the hold times keep it from flapping between levels.
+//
+// Counters record how often and why the level moved and how long each level was held.
+//
+class QualityGovernor
+{
+public:
+	void SetFrameBudgetSeconds(double budgetSeconds) { m_budgetSeconds = budgetSeconds; }
+	void SetForcedLevel(int level);		// negative hands control back to the governor
+	void AddFrame(double workSeconds, double frameSeconds);
+
+	int GetLevel() const { return m_level; }
+	QualitySettings const& GetSettings() const;
+	bool IsForced() const { return m_isForced; }
+	double GetFrameBudgetSeconds() const { return m_budgetSeconds; }
+	double GetSmoothedWorkSeconds() const { return m_smoothedWorkSeconds; }
+
+	int GetNumFrames() const { return m_numFrames; }
+	int GetNumFramesOverBudget() const { return m_numFramesOverBudget; }
+	int GetNumLowerings() const { return m_numLowerings; }
+	int GetNumRaisings() const { return m_numRaisings; }
+	double GetSecondsAtLevel(int level) const { return m_secondsAtLevel[level]; }
+	QualityChangeReason GetLastChangeReason() const { return m_lastChangeReason; }
+	int GetLastChangeFrame() const { return m_lastChangeFrame; }
+	double GetLastChangeWorkSeconds() const { return m_lastChangeWorkSeconds; }	// smoothed, when the level last moved
+
+	static char const* GetReasonName(QualityChangeReason reason);
+
+private:
+	void ChangeLevel(int level, QualityChangeReason reason);
+
+private:
+	double				m_budgetSeconds = QUALITY_DEFAULT_FRAME_BUDGET_SECONDS;
+	int					m_level = 0;
+	bool				m_isForced = false;
+	double				m_smoothedWorkSeconds = 0.0;
+	double				m_overBudgetSeconds = 0.0;
+	double				m_underBudgetSeconds = 0.0;
+
+	int					m_numFrames = 0;
+	int					m_numFramesOverBudget = 0;
+	int					m_numLowerings = 0;
+	int					m_numRaisings = 0;
+	double				m_secondsAtLevel[NUM_QUALITY_LEVELS] = {};
+	QualityChangeReason	m_lastChangeReason = QUALITY_NOT_CHANGED;
+	int					m_lastChangeFrame = 0;
+	double				m_lastChangeWorkSeconds = 0.0;
+};
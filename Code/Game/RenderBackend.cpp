@@ -0,0 +1,67 @@
+#include "Game/RenderBackend.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/Camera.hpp"
+
+EngineRenderBackend::EngineRenderBackend(Renderer* renderer)
+	: m_renderer(renderer)
+{
+}
+
+void EngineRenderBackend::ClearScreen(Rgba8 const& clearColor)
+{
+	m_renderer->ClearScreen(clearColor);
+}
+
+void EngineRenderBackend::BeginCamera(Camera const& camera)
+{
+	m_renderer->BeginCamera(camera);
+}
+
+void EngineRenderBackend::EndCamera(Camera const& camera)
+{
+	m_renderer->EndCamera(camera);
+}
+
+void EngineRenderBackend::SetViewport(ViewportData const& viewport)
+{
+	m_renderer->SetViewport(viewport);
+}
+
+void EngineRenderBackend::SetBlendMode(BlendMode blendMode)
+{
+	m_renderer->SetBlendMode(blendMode);
+}
+
+void EngineRenderBackend::BindTexture(Texture const* texture)
+{
+	m_renderer->BindTexture(texture);
+}
+
+void EngineRenderBackend::DrawVertexArray(int numVerts, Vertex_PCU const* verts)
+{
+	m_renderer->DrawVertexArray(numVerts, verts);
+}
+
+//-----------------------------------------------------------------------------------------------
+// The engine renderer only takes plain triangle lists, so the indexes are resolved here into a
+// scratch array owned by the render thread. The world command list never comes through here; it
+// is flattened on the prep thread. Only the small indexed draws made on the main thread (the
+// starfield, the attract screen ships) pay this copy.
+//
+void EngineRenderBackend::DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes)
+{
+	UNUSED(numVerts);
+	m_resolvedVerts.resize(numIndexes);
+	for (int indexIndex = 0; indexIndex < numIndexes; ++indexIndex)
+	{
+		m_resolvedVerts[indexIndex] = verts[indexes[indexIndex]];
+	}
+	m_renderer->DrawVertexArray(numIndexes, m_resolvedVerts.data());
+}
+
+//-----------------------------------------------------------------------------------------------
+// Nothing is queued here; the engine presents in Renderer::EndFrame.
+//
+void EngineRenderBackend::EndFrame()
+{
+}
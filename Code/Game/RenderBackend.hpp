@@ -0,0 +1,54 @@
+#pragma once
+#include "Game/EngineBuildPreferences.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include <vector>
+
+class Camera;
+class Texture;
+
+//-----------------------------------------------------------------------------------------------
+// The slice of the renderer the game draws through: cameras with ortho views, viewports, blend
+// modes, textures and plain or indexed triangle lists. EngineRenderBackend passes everything on
+// to the engine Renderer; SoftwareRasterizer draws the same calls on the CPU for machines without
+// a GPU. Device setup and presenting stay on g_theRenderer, which only exists with a GPU.
+//
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+
+	virtual void ClearScreen(Rgba8 const& clearColor) = 0;
+	virtual void BeginCamera(Camera const& camera) = 0;
+	virtual void EndCamera(Camera const& camera) = 0;
+	virtual void SetViewport(ViewportData const& viewport) = 0;
+	virtual void SetBlendMode(BlendMode blendMode) = 0;
+	virtual void BindTexture(Texture const* texture) = 0;
+	virtual void DrawVertexArray(int numVerts, Vertex_PCU const* verts) = 0;
+	virtual void DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes) = 0;
+	virtual void EndFrame() = 0;
+
+	// True when the last frame's image survives to the next frame if nothing at all is drawn
+	virtual bool KeepsLastFrame() const { return false; }
+};
+
+class EngineRenderBackend : public RenderBackend
+{
+public:
+	explicit EngineRenderBackend(Renderer* renderer);
+
+	virtual void ClearScreen(Rgba8 const& clearColor) override;
+	virtual void BeginCamera(Camera const& camera) override;
+	virtual void EndCamera(Camera const& camera) override;
+	virtual void SetViewport(ViewportData const& viewport) override;
+	virtual void SetBlendMode(BlendMode blendMode) override;
+	virtual void BindTexture(Texture const* texture) override;
+	virtual void DrawVertexArray(int numVerts, Vertex_PCU const* verts) override;
+	virtual void DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes) override;
+	virtual void EndFrame() override;
+
+private:
+	Renderer*				m_renderer = nullptr;
+	std::vector<Vertex_PCU>	m_resolvedVerts;
+};
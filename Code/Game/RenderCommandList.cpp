@@ -0,0 +1,130 @@
+#include "Game/RenderCommandList.hpp"
+#include "Game/MeshLibrary.hpp"
+#include "Game/BatchTransform.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+RenderCommandList::RenderCommandList()
+{
+	m_instances.reserve(COMMAND_LIST_INITIAL_INSTANCES);
+	m_verts.reserve(COMMAND_LIST_INITIAL_VERTS);
+	m_uniqueVerts.reserve(COMMAND_LIST_INITIAL_VERTS);
+}
+
+RenderCommandList::~RenderCommandList()
+{
+}
+
+void RenderCommandList::Clear()
+{
+	m_instances.clear();
+	m_verts.clear();
+	m_draws.clear();
+	m_numStateChanges = 0;
+}
+
+RenderInstance& RenderCommandList::AddInstance(RenderSortKey sortKey)
+{
+	if (m_draws.empty() || m_draws.back().m_sortKey != sortKey)
+	{
+		RenderDraw draw;
+		draw.m_sortKey = sortKey;
+		draw.m_blendMode = GetSortKeyBlendMode(sortKey);
+		draw.m_meshId = GetSortKeyMesh(sortKey);
+		draw.m_firstInstance = GetNumInstances();
+
+		bool isFirstDraw = m_draws.empty();
+		RenderSortKey previousKey = isFirstDraw ? 0 : m_draws.back().m_sortKey;
+		draw.m_setsBlendMode = isFirstDraw || GetSortKeyBlendMode(previousKey) != draw.m_blendMode;
+		draw.m_setsShader = isFirstDraw || GetSortKeyShader(previousKey) != GetSortKeyShader(sortKey);
+		draw.m_setsTexture = isFirstDraw || GetSortKeyTexture(previousKey) != GetSortKeyTexture(sortKey);
+		m_numStateChanges += (draw.m_setsBlendMode ? 1 : 0) + (draw.m_setsShader ? 1 : 0) + (draw.m_setsTexture ? 1 : 0);
+		m_draws.push_back(draw);
+	}
+
+	m_draws.back().m_numInstances += 1;
+	m_instances.emplace_back();
+	return m_instances.back();
+}
+
+void RenderCommandList::ExpandInstances(MeshLibrary const& meshLibrary)
+{
+	m_verts.clear();
+	for (int drawIndex = 0; drawIndex < static_cast<int>(m_draws.size()); ++drawIndex)
+	{
+		RenderDraw& draw = m_draws[drawIndex];
+		Vertex_PCU const* meshVerts = meshLibrary.GetVerts(draw.m_meshId);
+		int numMeshVerts = meshLibrary.GetNumVerts(draw.m_meshId);
+		unsigned int const* meshIndexes = meshLibrary.GetIndexes(draw.m_meshId);
+		int numMeshIndexes = meshLibrary.GetNumIndexes(draw.m_meshId);
+
+		// The engine renderer only takes triangle lists: transform the unique vertices, then flatten
+		// them through the mesh indexes here on the prep thread so the main thread draws the result as is
+		m_uniqueVerts.resize(numMeshVerts * draw.m_numInstances);
+		TransformInstances(meshLibrary.GetLocalXs(draw.m_meshId), meshLibrary.GetLocalYs(draw.m_meshId), meshVerts, numMeshVerts,
+						   &m_instances[draw.m_firstInstance], draw.m_numInstances, m_uniqueVerts.data());
+
+		draw.m_firstVert = GetNumVerts();
+		draw.m_numVerts = numMeshIndexes * draw.m_numInstances;
+		m_verts.resize(draw.m_firstVert + draw.m_numVerts);
+
+		Vertex_PCU* verts = m_verts.data() + draw.m_firstVert;
+		for (int instanceIndex = 0; instanceIndex < draw.m_numInstances; ++instanceIndex)
+		{
+			Vertex_PCU const* instanceVerts = m_uniqueVerts.data() + instanceIndex * numMeshVerts;
+			for (int indexIndex = 0; indexIndex < numMeshIndexes; ++indexIndex)
+			{
+				verts[indexIndex] = instanceVerts[meshIndexes[indexIndex]];
+			}
+			verts += numMeshIndexes;
+		}
+	}
+}
+
+void RenderCommandList::Submit() const
+{
+	for (int drawIndex = 0; drawIndex < static_cast<int>(m_draws.size()); ++drawIndex)
+	{
+		RenderDraw const& draw = m_draws[drawIndex];
+		if (draw.m_setsBlendMode)
+		{
+			g_theRenderBackend->SetBlendMode(draw.m_blendMode);
+		}
+		if (draw.m_setsTexture)
+		{
+			g_theRenderBackend->BindTexture(nullptr);
+		}
+		g_theRenderBackend->DrawVertexArray(draw.m_numVerts, &m_verts[draw.m_firstVert]);
+	}
+}
+
+RenderSortKey MakeRenderSortKey(unsigned char layer, BlendMode blendMode, unsigned char shaderId, unsigned char textureId, unsigned short meshId)
+{
+	return (static_cast<RenderSortKey>(layer) << 24) | (static_cast<RenderSortKey>(blendMode) << 20) |
+		   (static_cast<RenderSortKey>(shaderId) << 16) | (static_cast<RenderSortKey>(textureId) << 8) | static_cast<RenderSortKey>(meshId);
+}
+
+//-----------------------------------------------------------------------------------------------
+// Scales, rotates by (cos, sin) and translates one copy of a mesh, and multiplies its vertex
+// colors by the tint. TransformInstances must produce exactly the same vertices.
+//
+void ExpandInstance(Vertex_PCU const* meshVerts, int numVerts, RenderInstance const& instance, Vertex_PCU* out_verts)
+{
+	float cosine = instance.m_rotation.x;
+	float sine = instance.m_rotation.y;
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		Vertex_PCU const& meshVert = meshVerts[vertIndex];
+		float localX = meshVert.m_position.x * instance.m_scale.x;
+		float localY = meshVert.m_position.y * instance.m_scale.y;
+
+		Vertex_PCU& vert = out_verts[vertIndex];
+		vert = meshVert;
+		vert.m_position.x = instance.m_position.x + (cosine * localX - sine * localY);
+		vert.m_position.y = instance.m_position.y + (sine * localX + cosine * localY);
+		vert.m_color.r = static_cast<unsigned char>((meshVert.m_color.r * instance.m_tint.r + 127) / 255);
+		vert.m_color.g = static_cast<unsigned char>((meshVert.m_color.g * instance.m_tint.g + 127) / 255);
+		vert.m_color.b = static_cast<unsigned char>((meshVert.m_color.b * instance.m_tint.b + 127) / 255);
+		vert.m_color.a = static_cast<unsigned char>((meshVert.m_color.a * instance.m_tint.a + 127) / 255);
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "Game/EngineBuildPreferences.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include <vector>
+
+class MeshLibrary;
+
+constexpr int COMMAND_LIST_INITIAL_VERTS = 32768;
+constexpr int COMMAND_LIST_INITIAL_INSTANCES = 4096;
+
+//-----------------------------------------------------------------------------------------------
+// One placed copy of a mesh: translation, rotation as (cos, sin), scale and a tint that
+// multiplies the mesh vertex colors.
+//
+struct RenderInstance
+{
+	Vec2	m_position;
+	Vec2	m_rotation;
+	Vec2	m_scale;
+	Rgba8	m_tint;
+};
+
+enum RenderShaderId : unsigned char
+{
+	RENDER_SHADER_MESH,
+	NUM_RENDER_SHADERS
+};
+
+enum RenderTextureId : unsigned char
+{
+	RENDER_TEXTURE_NONE,
+	NUM_RENDER_TEXTURES
+};
+
+//-----------------------------------------------------------------------------------------------
+// Everything a world draw depends on, packed most significant first: layer, blend mode, shader,
+// texture and mesh, one byte each except blend mode and shader, which share one. Instances are
+// stable-sorted by key once per frame, so equal state is contiguous and a list changes state at
+// most once per distinct key in use, however many entities there are.
+//
+typedef unsigned int RenderSortKey;
+
+RenderSortKey MakeRenderSortKey(unsigned char layer, BlendMode blendMode, unsigned char shaderId, unsigned char textureId, unsigned short meshId);
+inline BlendMode GetSortKeyBlendMode(RenderSortKey key) { return static_cast<BlendMode>((key >> 20) & 0xF); }
+inline unsigned char GetSortKeyShader(RenderSortKey key) { return static_cast<unsigned char>((key >> 16) & 0xF); }
+inline unsigned char GetSortKeyTexture(RenderSortKey key) { return static_cast<unsigned char>((key >> 8) & 0xFF); }
+inline unsigned short GetSortKeyMesh(RenderSortKey key) { return static_cast<unsigned short>(key & 0xFF); }
+
+//-----------------------------------------------------------------------------------------------
+// One instanced draw of a shared mesh under one sort key. The m_sets flags mark the state that
+// differs from the previous draw; the first draw of a list sets everything.
+//
+struct RenderDraw
+{
+	RenderSortKey	m_sortKey = 0;
+	bool			m_setsBlendMode = false;
+	bool			m_setsShader = false;
+	bool			m_setsTexture = false;
+	BlendMode		m_blendMode = BlendMode::ALPHA;
+	unsigned short	m_meshId = 0;
+	int				m_firstInstance = 0;
+	int				m_numInstances = 0;
+	int				m_firstVert = 0;
+	int				m_numVerts = 0;
+};
+
+//-----------------------------------------------------------------------------------------------
+// A recorded stream of mesh instances, added in sort key order. Consecutive instances with the
+// same key form one draw. ExpandInstances transforms each mesh's unique vertices once per
+// instance with TransformInstances, then flattens them through the mesh indexes, because the
+// engine renderer only takes triangle lists. The draws are plain triangle lists and the main
+// thread copies nothing; the indexed meshes only save transform work, not submitted vertices.
+//
+class RenderCommandList
+{
+public:
+	RenderCommandList();
+	~RenderCommandList();
+
+	void Clear();
+	RenderInstance& AddInstance(RenderSortKey sortKey);
+	void ExpandInstances(MeshLibrary const& meshLibrary);
+
+	void Submit() const;
+
+	int GetNumInstances() const { return static_cast<int>(m_instances.size()); }
+	int GetNumVerts() const { return static_cast<int>(m_verts.size()); }
+	int GetNumDraws() const { return static_cast<int>(m_draws.size()); }
+	int GetNumStateChanges() const { return m_numStateChanges; }
+
+private:
+	std::vector<RenderInstance>	m_instances;
+	std::vector<Vertex_PCU>		m_verts;
+	std::vector<Vertex_PCU>		m_uniqueVerts;		// transformed unique vertices of the draw being flattened
+	std::vector<RenderDraw>		m_draws;
+	int							m_numStateChanges = 0;
+};
+
+void ExpandInstance(Vertex_PCU const* meshVerts, int numVerts, RenderInstance const& instance, Vertex_PCU* out_verts);
@@ -0,0 +1,88 @@
+#include "Game/RenderPrepThread.hpp"
+#include "Game/RenderCommandList.hpp"
+#include "Engine/Core/Time.hpp"
+
+RenderPrepThread::RenderPrepThread(MeshLibrary const& meshLibrary)
+	: m_meshLibrary(meshLibrary)
+{
+	for (int viewIndex = 0; viewIndex < MAX_RENDER_VIEWS; ++viewIndex)
+	{
+		m_threads[viewIndex] = std::thread(&RenderPrepThread::ThreadMain, this, viewIndex);
+	}
+}
+
+RenderPrepThread::~RenderPrepThread()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_stateChanged.wait(lock, [this]() { return m_numViewsRemaining == 0; });
+		m_isShuttingDown = true;
+	}
+	m_stateChanged.notify_all();
+	for (int viewIndex = 0; viewIndex < MAX_RENDER_VIEWS; ++viewIndex)
+	{
+		m_threads[viewIndex].join();
+	}
+}
+
+void RenderPrepThread::Kick(RenderSnapshot const* snapshot, RenderCommandList* out_commandLists)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_stateChanged.wait(lock, [this]() { return m_numViewsRemaining == 0; });
+	m_snapshot = snapshot;
+	m_commandLists = out_commandLists;
+	m_numViewsRemaining = snapshot->m_numViews;
+	m_jobStartSeconds = GetCurrentTimeSeconds();
+	m_jobIndex += 1;
+	lock.unlock();
+	m_stateChanged.notify_all();
+}
+
+void RenderPrepThread::WaitUntilIdle()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_stateChanged.wait(lock, [this]() { return m_numViewsRemaining == 0; });
+}
+
+double RenderPrepThread::GetLastPrepSeconds() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_lastPrepSeconds;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Workers whose view is not in the current snapshot just note the job and go back to sleep.
+//
+void RenderPrepThread::ThreadMain(int viewIndex)
+{
+	unsigned int lastJobIndex = 0;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;)
+	{
+		m_stateChanged.wait(lock, [this, lastJobIndex]() { return m_jobIndex != lastJobIndex || m_isShuttingDown; });
+		if (m_isShuttingDown)
+		{
+			return;
+		}
+
+		lastJobIndex = m_jobIndex;
+		RenderSnapshot const* snapshot = m_snapshot;
+		if (viewIndex >= snapshot->m_numViews)
+		{
+			continue;
+		}
+
+		RenderCommandList* commandList = &m_commandLists[viewIndex];
+		lock.unlock();
+
+		BuildWorldCommandList(*snapshot, viewIndex, m_meshLibrary, m_sortScratch[viewIndex], *commandList);
+
+		lock.lock();
+		m_numViewsRemaining -= 1;
+		if (m_numViewsRemaining == 0)
+		{
+			m_lastPrepSeconds = GetCurrentTimeSeconds() - m_jobStartSeconds;
+			m_stateChanged.notify_all();
+		}
+	}
+}
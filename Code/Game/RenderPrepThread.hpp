@@ -0,0 +1,43 @@
+#pragma once
+#include "Game/RenderSnapshot.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class MeshLibrary;
+class RenderCommandList;
+
+//-----------------------------------------------------------------------------------------------
+// Builds the world command lists for one snapshot in the background while the next tick
+// simulates. Each view has its own worker thread, so the culled per-viewport lists are built in
+// parallel. At most one job is in flight; Kick waits for the previous one to finish.
+//
+class RenderPrepThread
+{
+public:
+	explicit RenderPrepThread(MeshLibrary const& meshLibrary);
+	~RenderPrepThread();
+
+	void Kick(RenderSnapshot const* snapshot, RenderCommandList* out_commandLists);
+	void WaitUntilIdle();
+
+	double GetLastPrepSeconds() const;
+
+private:
+	void ThreadMain(int viewIndex);
+
+private:
+	MeshLibrary const&			m_meshLibrary;
+	std::thread					m_threads[MAX_RENDER_VIEWS];
+	RenderSortScratch			m_sortScratch[MAX_RENDER_VIEWS];
+	mutable std::mutex			m_mutex;
+	std::condition_variable		m_stateChanged;
+	RenderSnapshot const*		m_snapshot = nullptr;
+	RenderCommandList*			m_commandLists = nullptr;
+	unsigned int				m_jobIndex = 0;
+	int							m_numViewsRemaining = 0;
+	bool						m_isShuttingDown = false;
+	double						m_jobStartSeconds = 0.0;
+	double						m_lastPrepSeconds = 0.0;
+};
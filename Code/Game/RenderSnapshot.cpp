@@ -0,0 +1,223 @@
+#include "Game/RenderSnapshot.hpp"
+#include "Game/RenderCommandList.hpp"
+#include "Game/MeshLibrary.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+RenderSnapshot::RenderSnapshot()
+{
+	m_proxies.reserve(SNAPSHOT_INITIAL_CAPACITY);
+}
+
+RenderSnapshot::~RenderSnapshot()
+{
+}
+
+void RenderSnapshot::Clear()
+{
+	m_proxies.clear();
+	m_debugShapes.Clear();
+}
+
+//-----------------------------------------------------------------------------------------------
+// True when both snapshots would draw the same world: same views seen through the same cameras,
+// same game time (the starfield twinkle), the same proxies in the same order and the same debug
+// shapes.
+//
+bool RenderSnapshot::IsSameFrameAs(RenderSnapshot const& other) const
+{
+	if (m_numViews != other.m_numViews || m_gameSeconds != other.m_gameSeconds || m_showHealthBars != other.m_showHealthBars || m_proxies.size() != other.m_proxies.size())
+	{
+		return false;
+	}
+
+	for (int viewIndex = 0; viewIndex < m_numViews; ++viewIndex)
+	{
+		bool isSameView = m_viewBounds[viewIndex].m_mins == other.m_viewBounds[viewIndex].m_mins && m_viewBounds[viewIndex].m_maxs == other.m_viewBounds[viewIndex].m_maxs &&
+						  m_worldCameras[viewIndex].GetOrthographicBottomLeft() == other.m_worldCameras[viewIndex].GetOrthographicBottomLeft() &&
+						  m_worldCameras[viewIndex].GetOrthographicTopRight() == other.m_worldCameras[viewIndex].GetOrthographicTopRight();
+		if (!isSameView)
+		{
+			return false;
+		}
+	}
+
+	for (int proxyIndex = 0; proxyIndex < static_cast<int>(m_proxies.size()); ++proxyIndex)
+	{
+		RenderProxy const& proxy = m_proxies[proxyIndex];
+		RenderProxy const& otherProxy = other.m_proxies[proxyIndex];
+		bool isSameProxy = proxy.m_meshId == otherProxy.m_meshId && proxy.m_layer == otherProxy.m_layer && proxy.m_position == otherProxy.m_position &&
+						   proxy.m_orientationDegrees == otherProxy.m_orientationDegrees && proxy.m_scale == otherProxy.m_scale && proxy.m_tint == otherProxy.m_tint &&
+						   proxy.m_viewMask == otherProxy.m_viewMask && proxy.m_viewLods == otherProxy.m_viewLods;
+		if (!isSameProxy)
+		{
+			return false;
+		}
+	}
+	return m_debugShapes.IsSameAs(other.m_debugShapes);
+}
+
+RenderProxy& RenderSnapshot::AddProxy(unsigned short meshId, unsigned char layer, Vec2 const& position, float orientationDegrees, Rgba8 const& tint)
+{
+	m_proxies.emplace_back();
+	RenderProxy& proxy = m_proxies.back();
+	proxy.m_meshId = meshId;
+	proxy.m_layer = layer;
+	proxy.m_position = position;
+	proxy.m_orientationDegrees = orientationDegrees;
+	proxy.m_scale = Vec2(1.f, 1.f);
+	proxy.m_tint = tint;
+	proxy.m_viewMask = m_currentViewMask;
+	proxy.m_viewLods = m_currentViewLods;
+	return proxy;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Matches AddVertsForLine2D: the quad extends half a thickness past both end points.
+//
+void RenderSnapshot::AddLine(unsigned char layer, Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color)
+{
+	Vec2 startToEnd = endPos - startPos;
+	float length = startToEnd.GetLength();
+	Vec2 forward = length > 0.f ? startToEnd / length : Vec2(1.f, 0.f);
+	float halfThickness = 0.5f * thickness;
+
+	RenderProxy& proxy = AddProxy(MESH_LINE, layer, startPos - forward * halfThickness, Atan2Degrees(forward.y, forward.x), color);
+	proxy.m_scale = Vec2(length + thickness, thickness);
+}
+
+unsigned char RenderSnapshot::GetViewMaskForDisc(Vec2 const& center, float radius) const
+{
+	unsigned char viewMask = 0;
+	for (int viewIndex = 0; viewIndex < m_numViews; ++viewIndex)
+	{
+		AABB2 const& bounds = m_viewBounds[viewIndex];
+		if (center.x + radius >= bounds.m_mins.x && center.x - radius <= bounds.m_maxs.x &&
+			center.y + radius >= bounds.m_mins.y && center.y - radius <= bounds.m_maxs.y)
+		{
+			viewMask |= static_cast<unsigned char>(1 << viewIndex);
+		}
+	}
+	return viewMask;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Picks the mesh LOD of a disc for every view in viewMask from its radius on that view's screen.
+// Views outside the mask keep their previous LOD, so an entity coming back into view starts from
+// where it left.
+//
+unsigned char RenderSnapshot::GetViewLodsForDisc(float radius, unsigned char viewMask, unsigned char previousViewLods) const
+{
+	unsigned char viewLods = previousViewLods;
+	for (int viewIndex = 0; viewIndex < m_numViews; ++viewIndex)
+	{
+		if ((viewMask & (1 << viewIndex)) == 0)
+		{
+			continue;
+		}
+
+		int shift = 2 * viewIndex;
+		int previousLod = (previousViewLods >> shift) & 3;
+		int lod = SelectMeshLod(radius * m_viewPixelsPerUnit[viewIndex] * m_lodPixelScale, previousLod);
+		viewLods = static_cast<unsigned char>((viewLods & ~(3 << shift)) | (lod << shift));
+	}
+	return viewLods;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Blend mode of each layer. Everything has always ended up alpha blended: the stars used to force
+// it per entity before any other layer drew, and the starfield now does the same once per view.
+//
+static BlendMode const s_layerBlendModes[NUM_RENDER_LAYERS] =
+{
+	BlendMode::ALPHA,	// LAYER_BULLETS
+	BlendMode::ALPHA,	// LAYER_ASTEROIDS
+	BlendMode::ALPHA,	// LAYER_DEBRIS
+	BlendMode::ALPHA,	// LAYER_ENEMIES
+	BlendMode::ALPHA,	// LAYER_SHIPS
+};
+
+static_assert(NUM_MESH_IDS <= 256, "mesh ids must fit in the low byte of a RenderSortKey");
+static_assert(NUM_MESH_LODS <= 4 && MAX_RENDER_VIEWS <= 4, "a proxy's LODs must fit in its 8 bits of m_viewLods");
+
+//-----------------------------------------------------------------------------------------------
+// Stable LSD radix sort of the scratch keys, carrying the proxy order along, one byte per pass.
+// A byte every key shares (usually shader and texture) is skipped.
+//
+static void SortByRenderKey(RenderSortScratch& scratch)
+{
+	int numKeys = static_cast<int>(scratch.m_keys.size());
+	if (numKeys == 0)
+	{
+		return;
+	}
+	scratch.m_tempKeys.resize(numKeys);
+	scratch.m_tempProxyOrder.resize(numKeys);
+
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		int digitStarts[257] = {};
+		for (int keyIndex = 0; keyIndex < numKeys; ++keyIndex)
+		{
+			digitStarts[((scratch.m_keys[keyIndex] >> shift) & 0xFF) + 1] += 1;
+		}
+		if (digitStarts[((scratch.m_keys[0] >> shift) & 0xFF) + 1] == numKeys)
+		{
+			continue;
+		}
+		for (int digit = 0; digit < 256; ++digit)
+		{
+			digitStarts[digit + 1] += digitStarts[digit];
+		}
+
+		for (int keyIndex = 0; keyIndex < numKeys; ++keyIndex)
+		{
+			RenderSortKey key = scratch.m_keys[keyIndex];
+			int sortedIndex = digitStarts[(key >> shift) & 0xFF]++;
+			scratch.m_tempKeys[sortedIndex] = key;
+			scratch.m_tempProxyOrder[sortedIndex] = scratch.m_proxyOrder[keyIndex];
+		}
+		scratch.m_keys.swap(scratch.m_tempKeys);
+		scratch.m_proxyOrder.swap(scratch.m_tempProxyOrder);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Runs on the render prep thread. Reads only the snapshot and the immutable mesh library.
+// Only proxies seen by viewIndex are kept, each drawing the LOD of its mesh picked for this view.
+// Each gets a sort key from its layer's state and that mesh, and the keys are stable-sorted so each distinct key becomes one instanced draw; within a
+// key the extraction order is kept.
+//
+void BuildWorldCommandList(RenderSnapshot const& snapshot, int viewIndex, MeshLibrary const& meshLibrary, RenderSortScratch& scratch, RenderCommandList& out_commandList)
+{
+	out_commandList.Clear();
+	unsigned char viewBit = static_cast<unsigned char>(1 << viewIndex);
+
+	scratch.m_keys.clear();
+	scratch.m_proxyOrder.clear();
+	int numProxies = static_cast<int>(snapshot.m_proxies.size());
+	for (int proxyIndex = 0; proxyIndex < numProxies; ++proxyIndex)
+	{
+		RenderProxy const& proxy = snapshot.m_proxies[proxyIndex];
+		if (proxy.m_viewMask & viewBit)
+		{
+			unsigned short meshId = meshLibrary.GetLodMeshId(proxy.m_meshId, (proxy.m_viewLods >> (2 * viewIndex)) & 3);
+			scratch.m_keys.push_back(MakeRenderSortKey(proxy.m_layer, s_layerBlendModes[proxy.m_layer], RENDER_SHADER_MESH, RENDER_TEXTURE_NONE, meshId));
+			scratch.m_proxyOrder.push_back(proxyIndex);
+		}
+	}
+
+	SortByRenderKey(scratch);
+
+	for (int orderIndex = 0; orderIndex < static_cast<int>(scratch.m_proxyOrder.size()); ++orderIndex)
+	{
+		RenderProxy const& proxy = snapshot.m_proxies[scratch.m_proxyOrder[orderIndex]];
+		RenderInstance& instance = out_commandList.AddInstance(scratch.m_keys[orderIndex]);
+		instance.m_position = proxy.m_position;
+		instance.m_rotation = Vec2(CosDegrees(proxy.m_orientationDegrees), SinDegrees(proxy.m_orientationDegrees));
+		instance.m_scale = proxy.m_scale;
+		instance.m_tint = proxy.m_tint;
+	}
+
+	out_commandList.ExpandInstances(meshLibrary);
+}
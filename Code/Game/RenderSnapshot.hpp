@@ -0,0 +1,98 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Game/RenderCommandList.hpp"
+#include "Game/DebugDrawBatch.hpp"
+#include <vector>
+
+class MeshLibrary;
+
+constexpr int SNAPSHOT_INITIAL_CAPACITY = 4096;
+constexpr int MAX_RENDER_VIEWS = 4;
+constexpr float RENDER_CULL_PADDING = 2.f;	// health bars are drawn just outside the cosmetic disc
+
+//-----------------------------------------------------------------------------------------------
+// Draw order of the world, back to front, above the starfield. Proxies are extracted in layer
+// order.
+//
+enum RenderLayer : unsigned char
+{
+	LAYER_BULLETS,
+	LAYER_ASTEROIDS,
+	LAYER_DEBRIS,
+	LAYER_ENEMIES,
+	LAYER_SHIPS,
+	NUM_RENDER_LAYERS
+};
+
+//-----------------------------------------------------------------------------------------------
+// One mesh instance as the renderer sees it. Plain data with no pointers back into gameplay
+// memory; the final vertex color is the mesh color modulated by m_tint (alpha included).
+// Bit i of m_viewMask is set when the owning entity can be seen by view i, and bits 2i and 2i + 1
+// of m_viewLods hold the mesh LOD view i draws it with.
+//
+struct RenderProxy
+{
+	unsigned short	m_meshId;
+	unsigned char	m_layer;
+	Vec2			m_position;
+	float			m_orientationDegrees;
+	Vec2			m_scale;
+	Rgba8			m_tint;
+	unsigned char	m_viewMask;
+	unsigned char	m_viewLods;
+};
+
+//-----------------------------------------------------------------------------------------------
+// The world as it looked at the end of one tick. Built by the sim thread, read by the render
+// prep thread while the next tick simulates. Each view is one world camera; entities outside
+// every view are not extracted at all, and the rest are tagged with the views that see them.
+//
+class RenderSnapshot
+{
+public:
+	RenderSnapshot();
+	~RenderSnapshot();
+
+	void Clear();
+	RenderProxy& AddProxy(unsigned short meshId, unsigned char layer, Vec2 const& position, float orientationDegrees, Rgba8 const& tint);
+	void AddLine(unsigned char layer, Vec2 const& startPos, Vec2 const& endPos, float thickness, Rgba8 const& color);
+
+	unsigned char GetViewMaskForDisc(Vec2 const& center, float radius) const;
+	unsigned char GetViewLodsForDisc(float radius, unsigned char viewMask, unsigned char previousViewLods) const;
+	unsigned char GetAllViewsMask() const { return static_cast<unsigned char>((1 << m_numViews) - 1); }
+	void SetCurrentViewMask(unsigned char viewMask) { m_currentViewMask = viewMask; }
+	void SetCurrentViewLods(unsigned char viewLods) { m_currentViewLods = viewLods; }
+	bool IsSameFrameAs(RenderSnapshot const& other) const;
+
+public:
+	std::vector<RenderProxy>	m_proxies;
+	Camera						m_worldCameras[MAX_RENDER_VIEWS];
+	AABB2						m_viewBounds[MAX_RENDER_VIEWS];
+	float						m_viewPixelsPerUnit[MAX_RENDER_VIEWS] = {};
+	int							m_numViews = 1;
+	double						m_gameSeconds = 0.0;
+	float						m_lodPixelScale = 1.f;		// quality knob: below 1 picks coarser mesh LODs
+	bool						m_showHealthBars = true;
+	DebugShapeList				m_debugShapes;				// empty unless F1 debug drawing was on for this tick
+
+private:
+	unsigned char				m_currentViewMask = 0xFF;
+	unsigned char				m_currentViewLods = 0;
+};
+
+//-----------------------------------------------------------------------------------------------
+// Working memory for sorting one view's proxies, kept by its owner across frames so steady-state
+// frames do not allocate.
+//
+struct RenderSortScratch
+{
+	std::vector<RenderSortKey>	m_keys;
+	std::vector<int>			m_proxyOrder;
+	std::vector<RenderSortKey>	m_tempKeys;
+	std::vector<int>			m_tempProxyOrder;
+};
+
+void BuildWorldCommandList(RenderSnapshot const& snapshot, int viewIndex, MeshLibrary const& meshLibrary, RenderSortScratch& scratch, RenderCommandList& out_commandList);
@@ -0,0 +1,514 @@
+#include "Game/SoftwareRasterizer.hpp"
+#include "Game/TaskGraph.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include <fstream>
+#include <math.h>
+#include <string.h>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define SOFTWARE_RASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+//-----------------------------------------------------------------------------------------------
+// Rounded value / 255 for value in [0, 255 * 255], without a divide. The SSE2 blend does the same
+// arithmetic in 16-bit lanes, so both paths produce identical pixels.
+//
+static int DivideBy255(int value)
+{
+	value += 128;
+	return (value + (value >> 8)) >> 8;
+}
+
+static void BlendPixel(Rgba8& dest, Rgba8 const& source, BlendMode blendMode)
+{
+	int alpha = source.a;
+	int inverseAlpha = 255 - alpha;
+	switch (blendMode)
+	{
+	case BlendMode::ALPHA:
+		dest.r = static_cast<unsigned char>(DivideBy255(source.r * alpha + dest.r * inverseAlpha));
+		dest.g = static_cast<unsigned char>(DivideBy255(source.g * alpha + dest.g * inverseAlpha));
+		dest.b = static_cast<unsigned char>(DivideBy255(source.b * alpha + dest.b * inverseAlpha));
+		dest.a = static_cast<unsigned char>(DivideBy255(255 * alpha + dest.a * inverseAlpha));
+		break;
+	case BlendMode::ADDITIVE:
+	{
+		int r = dest.r + DivideBy255(source.r * alpha);
+		int g = dest.g + DivideBy255(source.g * alpha);
+		int b = dest.b + DivideBy255(source.b * alpha);
+		dest.r = static_cast<unsigned char>(r > 255 ? 255 : r);
+		dest.g = static_cast<unsigned char>(g > 255 ? 255 : g);
+		dest.b = static_cast<unsigned char>(b > 255 ? 255 : b);
+		break;
+	}
+	default:
+		dest = source;
+		break;
+	}
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height)
+	: m_width(width)
+	, m_height(height)
+	, m_nextTile(0)
+{
+	m_numTilesX = (width + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+	m_numTilesY = (height + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+	m_pitch = (width + 3) & ~3;
+	m_pixels.resize(m_pitch * height, Rgba8(0, 0, 0, 255));
+	m_tileBins.resize(m_numTilesX * m_numTilesY);
+
+	m_viewport.TopLeftX = 0.f;
+	m_viewport.TopLeftY = 0.f;
+	m_viewport.Width = static_cast<float>(width);
+	m_viewport.Height = static_cast<float>(height);
+	m_viewport.MinDepth = 0.f;
+	m_viewport.MaxDepth = 1.f;
+
+	int numWorkerThreads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+	if (numWorkerThreads < 1)
+	{
+		numWorkerThreads = 1;
+	}
+	else if (numWorkerThreads > MAX_RASTER_WORKERS - 1)
+	{
+		numWorkerThreads = MAX_RASTER_WORKERS - 1;
+	}
+	m_rasterGraph = new TaskGraph(numWorkerThreads);
+
+	// One task per worker; they share nothing but the tile counter, so all of them overlap
+	for (int workerIndex = 0; workerIndex < m_rasterGraph->GetNumWorkers(); ++workerIndex)
+	{
+		m_rasterGraph->AddTask("RasterTiles", TASK_RESOURCE_NONE, TASK_RESOURCE_NONE, [this]() { RasterizeTiles(); });
+	}
+}
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+	delete m_rasterGraph;
+	m_rasterGraph = nullptr;
+}
+
+void SoftwareRasterizer::ClearScreen(Rgba8 const& clearColor)
+{
+	Flush();
+	for (int pixelIndex = 0; pixelIndex < static_cast<int>(m_pixels.size()); ++pixelIndex)
+	{
+		m_pixels[pixelIndex] = clearColor;
+	}
+}
+
+void SoftwareRasterizer::BeginCamera(Camera const& camera)
+{
+	m_orthoMins = camera.GetOrthographicBottomLeft();
+	m_orthoMaxs = camera.GetOrthographicTopRight();
+}
+
+void SoftwareRasterizer::EndCamera(Camera const& camera)
+{
+	UNUSED(camera);
+}
+
+void SoftwareRasterizer::SetViewport(ViewportData const& viewport)
+{
+	m_viewport = viewport;
+}
+
+void SoftwareRasterizer::SetBlendMode(BlendMode blendMode)
+{
+	m_blendMode = blendMode;
+}
+
+void SoftwareRasterizer::BindTexture(Texture const* texture)
+{
+	m_isTextureBound = texture != nullptr;
+}
+
+void SoftwareRasterizer::DrawVertexArray(int numVerts, Vertex_PCU const* verts)
+{
+	if (m_isTextureBound)
+	{
+		return;
+	}
+
+	for (int vertIndex = 0; vertIndex + 2 < numVerts; vertIndex += 3)
+	{
+		AddTriangle(verts[vertIndex], verts[vertIndex + 1], verts[vertIndex + 2]);
+	}
+}
+
+void SoftwareRasterizer::DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes)
+{
+	UNUSED(numVerts);
+	if (m_isTextureBound)
+	{
+		return;
+	}
+
+	for (int indexIndex = 0; indexIndex + 2 < numIndexes; indexIndex += 3)
+	{
+		AddTriangle(verts[indexes[indexIndex]], verts[indexes[indexIndex + 1]], verts[indexes[indexIndex + 2]]);
+	}
+}
+
+void SoftwareRasterizer::EndFrame()
+{
+	Flush();
+}
+
+void SoftwareRasterizer::Flush()
+{
+	if (m_triangles.empty())
+	{
+		return;
+	}
+
+	m_numTrianglesLastFlush = static_cast<int>(m_triangles.size());
+	double startSeconds = GetCurrentTimeSeconds();
+	m_nextTile = 0;
+	m_rasterGraph->Execute();
+
+	m_triangles.clear();
+	for (int tileIndex = 0; tileIndex < static_cast<int>(m_tileBins.size()); ++tileIndex)
+	{
+		m_tileBins[tileIndex].clear();
+	}
+	m_lastFlushSeconds = GetCurrentTimeSeconds() - startSeconds;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Uncompressed 32-bit TGA with a top-left origin. Draws anything still queued first.
+//
+bool SoftwareRasterizer::WriteTGA(char const* filePath)
+{
+	Flush();
+
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	unsigned char header[18] = {};
+	header[2] = 2;		// uncompressed true-color
+	header[12] = static_cast<unsigned char>(m_width & 0xFF);
+	header[13] = static_cast<unsigned char>(m_width >> 8);
+	header[14] = static_cast<unsigned char>(m_height & 0xFF);
+	header[15] = static_cast<unsigned char>(m_height >> 8);
+	header[16] = 32;
+	header[17] = 0x28;	// top-left origin, 8 alpha bits
+	file.write(reinterpret_cast<char const*>(header), sizeof(header));
+
+	std::vector<unsigned char> row(m_width * 4);
+	for (int y = 0; y < m_height; ++y)
+	{
+		Rgba8 const* pixels = &m_pixels[y * m_pitch];
+		for (int x = 0; x < m_width; ++x)
+		{
+			row[4 * x + 0] = pixels[x].b;
+			row[4 * x + 1] = pixels[x].g;
+			row[4 * x + 2] = pixels[x].r;
+			row[4 * x + 3] = pixels[x].a;
+		}
+		file.write(reinterpret_cast<char const*>(row.data()), row.size());
+	}
+	return static_cast<bool>(file);
+}
+
+Vec2 SoftwareRasterizer::GetPixelPosition(Vec3 const& position) const
+{
+	float u = (position.x - m_orthoMins.x) / (m_orthoMaxs.x - m_orthoMins.x);
+	float v = (position.y - m_orthoMins.y) / (m_orthoMaxs.y - m_orthoMins.y);
+	float pixelX = m_viewport.TopLeftX + u * m_viewport.Width;
+	float pixelY = m_viewport.TopLeftY + (1.f - v) * m_viewport.Height;
+	return Vec2(roundf(pixelX * RASTER_SUBPIXEL_STEPS) / RASTER_SUBPIXEL_STEPS, roundf(pixelY * RASTER_SUBPIXEL_STEPS) / RASTER_SUBPIXEL_STEPS);
+}
+
+void SoftwareRasterizer::AddTriangle(Vertex_PCU const& vertA, Vertex_PCU const& vertB, Vertex_PCU const& vertC)
+{
+	Vec2 positions[3] = { GetPixelPosition(vertA.m_position), GetPixelPosition(vertB.m_position), GetPixelPosition(vertC.m_position) };
+	Rgba8 colors[3] = { vertA.m_color, vertB.m_color, vertC.m_color };
+
+	float area = (positions[1].x - positions[0].x) * (positions[2].y - positions[0].y) - (positions[1].y - positions[0].y) * (positions[2].x - positions[0].x);
+	if (area == 0.f)
+	{
+		return;
+	}
+	if (area < 0.f)
+	{
+		Vec2 swapPosition = positions[1];
+		positions[1] = positions[2];
+		positions[2] = swapPosition;
+		Rgba8 swapColor = colors[1];
+		colors[1] = colors[2];
+		colors[2] = swapColor;
+		area = -area;
+	}
+
+	// pixel x is covered by the triangle's bounds when its center x + 0.5 is
+	float minX = fminf(positions[0].x, fminf(positions[1].x, positions[2].x));
+	float maxX = fmaxf(positions[0].x, fmaxf(positions[1].x, positions[2].x));
+	float minY = fminf(positions[0].y, fminf(positions[1].y, positions[2].y));
+	float maxY = fmaxf(positions[0].y, fmaxf(positions[1].y, positions[2].y));
+	float clipMinX = fmaxf(m_viewport.TopLeftX, 0.f);
+	float clipMinY = fmaxf(m_viewport.TopLeftY, 0.f);
+	float clipMaxX = fminf(m_viewport.TopLeftX + m_viewport.Width, static_cast<float>(m_width));
+	float clipMaxY = fminf(m_viewport.TopLeftY + m_viewport.Height, static_cast<float>(m_height));
+
+	RasterTriangle triangle;
+	triangle.m_minX = static_cast<int>(ceilf(fmaxf(minX, clipMinX) - 0.5f));
+	triangle.m_minY = static_cast<int>(ceilf(fmaxf(minY, clipMinY) - 0.5f));
+	triangle.m_maxX = static_cast<int>(floorf(fminf(maxX, clipMaxX) - 0.5f));
+	triangle.m_maxY = static_cast<int>(floorf(fminf(maxY, clipMaxY) - 0.5f));
+	if (triangle.m_minX > triangle.m_maxX || triangle.m_minY > triangle.m_maxY)
+	{
+		return;
+	}
+
+	for (int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+	{
+		Vec2 const& start = positions[(edgeIndex + 1) % 3];
+		Vec2 const& end = positions[(edgeIndex + 2) % 3];
+		float edgeA = start.y - end.y;
+		float edgeB = end.x - start.x;
+		triangle.m_edgeA[edgeIndex] = edgeA;
+		triangle.m_edgeB[edgeIndex] = edgeB;
+		triangle.m_edgeC[edgeIndex] = (end.y - start.y) * start.x - (end.x - start.x) * start.y;
+		// the two triangles on a shared edge see it with opposite signs; exactly one owns it
+		triangle.m_ownsZero[edgeIndex] = edgeA > 0.f || (edgeA == 0.f && edgeB > 0.f);
+	}
+	triangle.m_inverseArea = 1.f / area;
+	triangle.m_colors[0] = colors[0];
+	triangle.m_colors[1] = colors[1];
+	triangle.m_colors[2] = colors[2];
+	triangle.m_isFlatColor = colors[0] == colors[1] && colors[0] == colors[2];
+	triangle.m_blendMode = m_blendMode;
+
+	int triangleIndex = static_cast<int>(m_triangles.size());
+	m_triangles.push_back(triangle);
+	for (int tileY = triangle.m_minY / RASTER_TILE_SIZE; tileY <= triangle.m_maxY / RASTER_TILE_SIZE; ++tileY)
+	{
+		for (int tileX = triangle.m_minX / RASTER_TILE_SIZE; tileX <= triangle.m_maxX / RASTER_TILE_SIZE; ++tileX)
+		{
+			m_tileBins[tileY * m_numTilesX + tileX].push_back(triangleIndex);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Runs on every raster worker at once; each claims the next undrawn tile until none are left.
+//
+void SoftwareRasterizer::RasterizeTiles()
+{
+	int numTiles = m_numTilesX * m_numTilesY;
+	for (int tileIndex = m_nextTile++; tileIndex < numTiles; tileIndex = m_nextTile++)
+	{
+		RasterizeTile(tileIndex);
+	}
+}
+
+void SoftwareRasterizer::RasterizeTile(int tileIndex)
+{
+	std::vector<int> const& bin = m_tileBins[tileIndex];
+	if (bin.empty())
+	{
+		return;
+	}
+
+	int tileMinX = (tileIndex % m_numTilesX) * RASTER_TILE_SIZE;
+	int tileMinY = (tileIndex / m_numTilesX) * RASTER_TILE_SIZE;
+	int tileMaxX = tileMinX + RASTER_TILE_SIZE - 1;
+	int tileMaxY = tileMinY + RASTER_TILE_SIZE - 1;
+	for (int binIndex = 0; binIndex < static_cast<int>(bin.size()); ++binIndex)
+	{
+		RasterTriangle const& triangle = m_triangles[bin[binIndex]];
+		int minX = triangle.m_minX > tileMinX ? triangle.m_minX : tileMinX;
+		int minY = triangle.m_minY > tileMinY ? triangle.m_minY : tileMinY;
+		int maxX = triangle.m_maxX < tileMaxX ? triangle.m_maxX : tileMaxX;
+		int maxY = triangle.m_maxY < tileMaxY ? triangle.m_maxY : tileMaxY;
+		RasterizeTriangle(triangle, minX, minY, maxX, maxY);
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Bit i of the result is set when the pixel centered at (centerX + i, centerY) is covered.
+//
+static int GetCoverageMask4(float const edgeA[3], float const edgeB[3], float const edgeC[3], bool const ownsZero[3], float centerX, float centerY)
+{
+#if defined(SOFTWARE_RASTER_SSE2)
+	__m128 const zero = _mm_setzero_ps();
+	__m128 centerXs = _mm_add_ps(_mm_set1_ps(centerX), _mm_set_ps(3.f, 2.f, 1.f, 0.f));
+	__m128 covered = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	for (int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+	{
+		__m128 weights = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[edgeIndex]), centerXs), _mm_set1_ps(edgeB[edgeIndex] * centerY + edgeC[edgeIndex]));
+		__m128 inside = _mm_cmpgt_ps(weights, zero);
+		if (ownsZero[edgeIndex])
+		{
+			inside = _mm_or_ps(inside, _mm_cmpeq_ps(weights, zero));
+		}
+		covered = _mm_and_ps(covered, inside);
+	}
+	return _mm_movemask_ps(covered);
+#else
+	int coverage = 0;
+	for (int lane = 0; lane < 4; ++lane)
+	{
+		bool isCovered = true;
+		for (int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+		{
+			float weight = edgeA[edgeIndex] * (centerX + static_cast<float>(lane)) + edgeB[edgeIndex] * centerY + edgeC[edgeIndex];
+			isCovered = isCovered && (weight > 0.f || (weight == 0.f && ownsZero[edgeIndex]));
+		}
+		coverage |= isCovered ? (1 << lane) : 0;
+	}
+	return coverage;
+#endif
+}
+
+void SoftwareRasterizer::RasterizeTriangle(RasterTriangle const& triangle, int minX, int minY, int maxX, int maxY)
+{
+#if defined(SOFTWARE_RASTER_SSE2)
+	if (triangle.m_isFlatColor)
+	{
+		RasterizeFlatTriangle(triangle, minX, minY, maxX, maxY);
+		return;
+	}
+#endif
+
+	for (int y = minY; y <= maxY; ++y)
+	{
+		float centerY = static_cast<float>(y) + 0.5f;
+		Rgba8* row = &m_pixels[y * m_pitch];
+		for (int x = minX; x <= maxX; x += 4)
+		{
+			int coverage = GetCoverageMask4(triangle.m_edgeA, triangle.m_edgeB, triangle.m_edgeC, triangle.m_ownsZero, static_cast<float>(x) + 0.5f, centerY);
+			if (maxX - x < 3)
+			{
+				coverage &= (1 << (maxX - x + 1)) - 1;
+			}
+
+			for (int lane = 0; coverage != 0; ++lane, coverage >>= 1)
+			{
+				if ((coverage & 1) == 0)
+				{
+					continue;
+				}
+
+				Rgba8 color = triangle.m_colors[0];
+				if (!triangle.m_isFlatColor)
+				{
+					float centerX = static_cast<float>(x + lane) + 0.5f;
+					float weight1 = (triangle.m_edgeA[1] * centerX + triangle.m_edgeB[1] * centerY + triangle.m_edgeC[1]) * triangle.m_inverseArea;
+					float weight2 = (triangle.m_edgeA[2] * centerX + triangle.m_edgeB[2] * centerY + triangle.m_edgeC[2]) * triangle.m_inverseArea;
+					float weight0 = 1.f - weight1 - weight2;
+					Rgba8 const* colors = triangle.m_colors;
+					color.r = static_cast<unsigned char>(weight0 * colors[0].r + weight1 * colors[1].r + weight2 * colors[2].r + 0.5f);
+					color.g = static_cast<unsigned char>(weight0 * colors[0].g + weight1 * colors[1].g + weight2 * colors[2].g + 0.5f);
+					color.b = static_cast<unsigned char>(weight0 * colors[0].b + weight1 * colors[1].b + weight2 * colors[2].b + 0.5f);
+					color.a = static_cast<unsigned char>(weight0 * colors[0].a + weight1 * colors[1].a + weight2 * colors[2].a + 0.5f);
+				}
+				BlendPixel(row[x + lane], color, triangle.m_blendMode);
+			}
+		}
+	}
+}
+
+#if defined(SOFTWARE_RASTER_SSE2)
+//-----------------------------------------------------------------------------------------------
+// Single-color triangles: edge values are stepped a block at a time instead of re-evaluated, and
+// the covered lanes of a block are blended together with the same arithmetic as BlendPixel.
+// Blocks start on multiples of 4, so lanes outside [minX, maxX] still lie in this tile's rows and
+// are written back unchanged.
+//
+void SoftwareRasterizer::RasterizeFlatTriangle(RasterTriangle const& triangle, int minX, int minY, int maxX, int maxY)
+{
+	Rgba8 const& color = triangle.m_colors[0];
+	int alpha = color.a;
+	Rgba8 additiveColor(static_cast<unsigned char>(DivideBy255(color.r * alpha)), static_cast<unsigned char>(DivideBy255(color.g * alpha)), static_cast<unsigned char>(DivideBy255(color.b * alpha)), 0);
+	int packedColor = 0;
+	int packedAdditiveColor = 0;
+	memcpy(&packedColor, &color, sizeof(packedColor));
+	memcpy(&packedAdditiveColor, &additiveColor, sizeof(packedAdditiveColor));
+
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const rounding = _mm_set1_epi16(128);
+	__m128i const inverseAlphas = _mm_set1_epi16(static_cast<short>(255 - alpha));
+	__m128i const sourceTerms = _mm_set_epi16(static_cast<short>(255 * alpha), static_cast<short>(color.b * alpha), static_cast<short>(color.g * alpha), static_cast<short>(color.r * alpha),
+		static_cast<short>(255 * alpha), static_cast<short>(color.b * alpha), static_cast<short>(color.g * alpha), static_cast<short>(color.r * alpha));
+	__m128i const additiveColors = _mm_set1_epi32(packedAdditiveColor);
+	__m128i const opaqueColors = _mm_set1_epi32(packedColor);
+
+	int firstBlockX = minX & ~3;
+	__m128i const laneOffsets = _mm_set_epi32(3, 2, 1, 0);
+	__m128i const afterMaxX = _mm_set1_epi32(maxX + 1);
+	__m128i const beforeMinX = _mm_set1_epi32(minX - 1);
+	__m128 const zeroWeights = _mm_setzero_ps();
+	__m128 const firstCenterXs = _mm_add_ps(_mm_set1_ps(static_cast<float>(firstBlockX) + 0.5f), _mm_set_ps(3.f, 2.f, 1.f, 0.f));
+	__m128 edgeAs[3];
+	__m128 blockSteps[3];
+	__m128 ownsZeroMasks[3];
+	for (int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+	{
+		edgeAs[edgeIndex] = _mm_set1_ps(triangle.m_edgeA[edgeIndex]);
+		blockSteps[edgeIndex] = _mm_set1_ps(4.f * triangle.m_edgeA[edgeIndex]);
+		ownsZeroMasks[edgeIndex] = _mm_castsi128_ps(_mm_set1_epi32(triangle.m_ownsZero[edgeIndex] ? -1 : 0));
+	}
+
+	for (int y = minY; y <= maxY; ++y)
+	{
+		float centerY = static_cast<float>(y) + 0.5f;
+		__m128 weights[3];
+		for (int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+		{
+			weights[edgeIndex] = _mm_add_ps(_mm_mul_ps(edgeAs[edgeIndex], firstCenterXs), _mm_set1_ps(triangle.m_edgeB[edgeIndex] * centerY + triangle.m_edgeC[edgeIndex]));
+		}
+
+		Rgba8* row = &m_pixels[y * m_pitch];
+		for (int x = firstBlockX; x <= maxX; x += 4)
+		{
+			__m128 covered = _mm_or_ps(_mm_cmpgt_ps(weights[0], zeroWeights), _mm_and_ps(ownsZeroMasks[0], _mm_cmpeq_ps(weights[0], zeroWeights)));
+			covered = _mm_and_ps(covered, _mm_or_ps(_mm_cmpgt_ps(weights[1], zeroWeights), _mm_and_ps(ownsZeroMasks[1], _mm_cmpeq_ps(weights[1], zeroWeights))));
+			covered = _mm_and_ps(covered, _mm_or_ps(_mm_cmpgt_ps(weights[2], zeroWeights), _mm_and_ps(ownsZeroMasks[2], _mm_cmpeq_ps(weights[2], zeroWeights))));
+			weights[0] = _mm_add_ps(weights[0], blockSteps[0]);
+			weights[1] = _mm_add_ps(weights[1], blockSteps[1]);
+			weights[2] = _mm_add_ps(weights[2], blockSteps[2]);
+
+			__m128i laneXs = _mm_add_epi32(_mm_set1_epi32(x), laneOffsets);
+			__m128i inRange = _mm_and_si128(_mm_cmpgt_epi32(laneXs, beforeMinX), _mm_cmplt_epi32(laneXs, afterMaxX));
+			__m128i writeMask = _mm_and_si128(_mm_castps_si128(covered), inRange);
+			if (_mm_movemask_epi8(writeMask) == 0)
+			{
+				continue;
+			}
+
+			__m128i* dest = reinterpret_cast<__m128i*>(&row[x]);
+			__m128i destColors = _mm_loadu_si128(dest);
+			__m128i blendedColors;
+			switch (triangle.m_blendMode)
+			{
+			case BlendMode::ALPHA:
+			{
+				__m128i low = _mm_add_epi16(_mm_add_epi16(sourceTerms, _mm_mullo_epi16(_mm_unpacklo_epi8(destColors, zero), inverseAlphas)), rounding);
+				__m128i high = _mm_add_epi16(_mm_add_epi16(sourceTerms, _mm_mullo_epi16(_mm_unpackhi_epi8(destColors, zero), inverseAlphas)), rounding);
+				low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+				high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+				blendedColors = _mm_packus_epi16(low, high);
+				break;
+			}
+			case BlendMode::ADDITIVE:
+				blendedColors = _mm_adds_epu8(destColors, additiveColors);
+				break;
+			default:
+				blendedColors = opaqueColors;
+				break;
+			}
+			_mm_storeu_si128(dest, _mm_or_si128(_mm_and_si128(writeMask, blendedColors), _mm_andnot_si128(writeMask, destColors)));
+		}
+	}
+}
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+#include "Game/RenderBackend.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include <atomic>
+#include <vector>
+
+class TaskGraph;
+
+constexpr int RASTER_TILE_SIZE = 64;			// in pixels; a tile is rasterized by one worker at a time
+constexpr float RASTER_SUBPIXEL_STEPS = 16.f;	// vertex positions snap to 1/16 of a pixel
+constexpr int MAX_RASTER_WORKERS = 8;
+
+//-----------------------------------------------------------------------------------------------
+// CPU rasterizer for the RenderBackend calls, for machines without a GPU: headless golden-image
+// checks, render cost numbers on CI, and frame export. Code/Tests renders a fixed frame with it
+// and compares that with Run/Data/Tests/SoftwareRasterizerGolden.tga.
+//
+// Draw calls only do triangle setup: vertices are mapped through the current camera and
+// viewport to pixels, and each triangle is binned into the screen tiles its bounds touch, with
+// the blend mode and viewport clip it was drawn with. Flush (EndFrame, or anything reading the
+// pixels) rasterizes all tiles in parallel on a TaskGraph; within a tile triangles are drawn in
+// submission order, so the result matches drawing them one by one. Coverage is tested four
+// pixels at a time with edge functions (SSE2 where available) and a top-left fill rule, so
+// triangles sharing an edge never blend a pixel twice. Flat-colored triangles, the bulk of a
+// frame, also blend four pixels at a time; blocks are aligned to 4 pixels and rows are padded to
+// a whole block so a block never straddles two tiles.
+//
+// Textures are not sampled: while a texture is bound, draws are skipped, so bitmap-font text is
+// missing from software frames.
+//
+class SoftwareRasterizer : public RenderBackend
+{
+public:
+	SoftwareRasterizer(int width, int height);
+	~SoftwareRasterizer();
+
+	virtual void ClearScreen(Rgba8 const& clearColor) override;
+	virtual void BeginCamera(Camera const& camera) override;
+	virtual void EndCamera(Camera const& camera) override;
+	virtual void SetViewport(ViewportData const& viewport) override;
+	virtual void SetBlendMode(BlendMode blendMode) override;
+	virtual void BindTexture(Texture const* texture) override;
+	virtual void DrawVertexArray(int numVerts, Vertex_PCU const* verts) override;
+	virtual void DrawIndexedVertexArray(int numVerts, Vertex_PCU const* verts, int numIndexes, unsigned int const* indexes) override;
+	virtual void EndFrame() override;
+	virtual bool KeepsLastFrame() const override { return true; }
+
+	void Flush();
+	bool WriteTGA(char const* filePath);
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+	int GetPitch() const { return m_pitch; }
+	Rgba8 const* GetPixels() const { return m_pixels.data(); }		// rows top to bottom, GetPitch() pixels apart
+	int GetNumTrianglesLastFlush() const { return m_numTrianglesLastFlush; }	// of the last flush that had any
+	double GetLastFlushSeconds() const { return m_lastFlushSeconds; }
+
+private:
+	//-----------------------------------------------------------------------------------------------
+	// Set up in pixel space, y down, wound so every edge function is positive inside.
+	// Edge i is m_edgeA[i] * x + m_edgeB[i] * y + m_edgeC[i]; a pixel center exactly on an edge
+	// belongs to the triangle only when the edge owns it (m_ownsZero[i]).
+	//
+	struct RasterTriangle
+	{
+		float		m_edgeA[3];
+		float		m_edgeB[3];
+		float		m_edgeC[3];
+		bool		m_ownsZero[3];
+		float		m_inverseArea;
+		Rgba8		m_colors[3];
+		bool		m_isFlatColor;
+		BlendMode	m_blendMode;
+		int			m_minX;
+		int			m_minY;
+		int			m_maxX;
+		int			m_maxY;
+	};
+
+	void AddTriangle(Vertex_PCU const& vertA, Vertex_PCU const& vertB, Vertex_PCU const& vertC);
+	Vec2 GetPixelPosition(Vec3 const& position) const;
+	void RasterizeTiles();
+	void RasterizeTile(int tileIndex);
+	void RasterizeTriangle(RasterTriangle const& triangle, int minX, int minY, int maxX, int maxY);
+	void RasterizeFlatTriangle(RasterTriangle const& triangle, int minX, int minY, int maxX, int maxY);
+
+private:
+	int								m_width = 0;
+	int								m_height = 0;
+	int								m_pitch = 0;		// width rounded up to whole 4-pixel blocks
+	int								m_numTilesX = 0;
+	int								m_numTilesY = 0;
+	std::vector<Rgba8>				m_pixels;
+
+	Vec2							m_orthoMins;
+	Vec2							m_orthoMaxs = Vec2(1.f, 1.f);
+	ViewportData					m_viewport;
+	BlendMode						m_blendMode = BlendMode::ALPHA;
+	bool							m_isTextureBound = false;
+
+	std::vector<RasterTriangle>		m_triangles;
+	std::vector<std::vector<int>>	m_tileBins;
+	TaskGraph*						m_rasterGraph = nullptr;
+	std::atomic<int>				m_nextTile;
+	int								m_numTrianglesLastFlush = 0;
+	double							m_lastFlushSeconds = 0.0;
+};
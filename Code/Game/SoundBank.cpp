@@ -0,0 +1,113 @@
+#include "Game/SoundBank.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <fstream>
+#include <string.h>
+
+//-----------------------------------------------------------------------------------------------
+// Indexed by SoundId. The AudioSystem has no length query, so .wav lengths are read from the
+// file headers at load; the MP3s carry hand-measured estimates instead. An estimate that is off
+// only moves when the VoiceManager frees the voice's slot (a little early lets one extra voice
+// overlap the tail, a little late can drop or steal for one that had finished), and the two
+// MP3s are jingles that play once per menu or game end, so they never meet a voice limit.
+//
+static constexpr SoundDefinition s_soundDefinitions[NUM_SOUND_IDS] =
+{
+	{ SOUND_BACK,				"Data/Audio/Back.wav",				SOUND_PRIORITY_CRITICAL,	1,				0.f },
+	{ SOUND_BE_HITTED,			"Data/Audio/BeHitted.wav",			SOUND_PRIORITY_HIT,			4,				0.f },
+	{ SOUND_COLLISION,			"Data/Audio/Collision.wav",			SOUND_PRIORITY_BUMP,		2,				0.f },
+	{ SOUND_DIE,				"Data/Audio/Die.wav",				SOUND_PRIORITY_HIT,			4,				0.f },
+	{ SOUND_FIRST_START,		"Data/Audio/FirstStart.mp3",		SOUND_PRIORITY_CRITICAL,	1,				8.2f },
+	{ SOUND_LOSE,				"Data/Audio/lose.wav",				SOUND_PRIORITY_CRITICAL,	1,				0.f },
+	{ SOUND_MULTIPLAYER,		"Data/Audio/Multiplayer.wav",		SOUND_PRIORITY_CRITICAL,	1,				0.f },
+	{ SOUND_MUSIC,				"Data/Audio/BuMianZhiYe.mp3",		SOUND_PRIORITY_CRITICAL,	1,				0.f },		// looped; only ever a controlled sound
+	{ SOUND_NEW_WAVE,			"Data/Audio/NewWave.wav",			SOUND_PRIORITY_CRITICAL,	1,				0.f },
+	{ SOUND_SHIP_DIE,			"Data/Audio/ShipDie.wav",			SOUND_PRIORITY_CRITICAL,	MAX_PLAYERS,	0.f },
+	{ SOUND_SHIP_RESPAWN,		"Data/Audio/ShipRespawn.wav",		SOUND_PRIORITY_CRITICAL,	MAX_PLAYERS,	0.f },
+	{ SOUND_SHOOT,				"Data/Audio/Shoot.wav",				SOUND_PRIORITY_WEAPON,		4,				0.f },
+	{ SOUND_SKILL_BULLETS,		"Data/Audio/SkillBullets.wav",		SOUND_PRIORITY_WEAPON,		2,				0.f },
+	{ SOUND_SKILL_COOL_DOWN,	"Data/Audio/SkillCoolDown.wav",		SOUND_PRIORITY_WEAPON,		2,				0.f },
+	{ SOUND_SKILL_INVINCIBLE,	"Data/Audio/SkillInvi.wav",			SOUND_PRIORITY_WEAPON,		2,				0.f },
+	{ SOUND_WIN,				"Data/Audio/win.mp3",				SOUND_PRIORITY_CRITICAL,	1,				4.8f },
+};
+
+//-----------------------------------------------------------------------------------------------
+// A row left out zero-initialises to SOUND_BACK with a null path, so checking each row's id
+// against its index catches a missing or misplaced row as well as a reordered enum.
+//
+static constexpr bool AreSoundDefinitionsInIdOrder()
+{
+	for (int soundIndex = 0; soundIndex < NUM_SOUND_IDS; ++soundIndex)
+	{
+		if (s_soundDefinitions[soundIndex].m_id != soundIndex || s_soundDefinitions[soundIndex].m_path == nullptr)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+static_assert(AreSoundDefinitionsInIdOrder(), "s_soundDefinitions needs one row per SoundId, in SoundId order");
+
+SoundDefinition const& GetSoundDefinition(SoundId soundId)
+{
+	return s_soundDefinitions[soundId];
+}
+
+static unsigned int ReadLittleEndianUInt(unsigned char const* bytes)
+{
+	return static_cast<unsigned int>(bytes[0]) | (static_cast<unsigned int>(bytes[1]) << 8) |
+		   (static_cast<unsigned int>(bytes[2]) << 16) | (static_cast<unsigned int>(bytes[3]) << 24);
+}
+
+//-----------------------------------------------------------------------------------------------
+// Length of a .wav from its fmt and data chunks, or 0 if the file is not a readable RIFF WAVE.
+//
+static float ReadWaveFileSeconds(char const* filePath)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	unsigned char riffHeader[12];
+	if (!file.read(reinterpret_cast<char*>(riffHeader), sizeof(riffHeader)) || memcmp(riffHeader, "RIFF", 4) != 0 || memcmp(&riffHeader[8], "WAVE", 4) != 0)
+	{
+		return 0.f;
+	}
+
+	unsigned int bytesPerSecond = 0;
+	unsigned char chunkHeader[8];
+	while (file.read(reinterpret_cast<char*>(chunkHeader), sizeof(chunkHeader)))
+	{
+		unsigned int chunkSize = ReadLittleEndianUInt(&chunkHeader[4]);
+		if (memcmp(chunkHeader, "data", 4) == 0)
+		{
+			return bytesPerSecond > 0 ? static_cast<float>(chunkSize) / static_cast<float>(bytesPerSecond) : 0.f;
+		}
+		if (memcmp(chunkHeader, "fmt ", 4) == 0 && chunkSize >= 16)
+		{
+			unsigned char format[16];
+			if (!file.read(reinterpret_cast<char*>(format), sizeof(format)))
+			{
+				return 0.f;
+			}
+			bytesPerSecond = ReadLittleEndianUInt(&format[8]);
+			chunkSize -= sizeof(format);
+		}
+		file.seekg(static_cast<std::streamoff>(chunkSize) + (chunkSize & 1), std::ios::cur);		// chunks are padded to even sizes
+	}
+	return 0.f;
+}
+
+void SoundBank::Load(AudioSystem& audioSystem)
+{
+	for (int soundIndex = 0; soundIndex < NUM_SOUND_IDS; ++soundIndex)
+	{
+		SoundDefinition const& definition = s_soundDefinitions[soundIndex];
+		m_sounds[soundIndex] = audioSystem.CreateOrGetSound(definition.m_path);
+
+		m_voiceSeconds[soundIndex] = ReadWaveFileSeconds(definition.m_path);
+		if (m_voiceSeconds[soundIndex] <= 0.f)
+		{
+			m_voiceSeconds[soundIndex] = definition.m_estimatedSeconds;
+		}
+		GUARANTEE_OR_DIE(m_voiceSeconds[soundIndex] > 0.f || soundIndex == SOUND_MUSIC, Stringf("No length for %s: not a readable .wav and no estimate", definition.m_path));
+	}
+}
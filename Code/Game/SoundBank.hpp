@@ -0,0 +1,67 @@
+#pragma once
+#include "Engine/Audio/AudioSystem.hpp"
+
+//-----------------------------------------------------------------------------------------------
+// Every sound the game plays, loaded once at startup. Gameplay names sounds by id, so starting
+// one is a table lookup with no path string built or hashed.
+//
+enum SoundId : unsigned char
+{
+	SOUND_BACK,
+	SOUND_BE_HITTED,
+	SOUND_COLLISION,
+	SOUND_DIE,
+	SOUND_FIRST_START,
+	SOUND_LOSE,
+	SOUND_MULTIPLAYER,
+	SOUND_MUSIC,
+	SOUND_NEW_WAVE,
+	SOUND_SHIP_DIE,
+	SOUND_SHIP_RESPAWN,
+	SOUND_SHOOT,
+	SOUND_SKILL_BULLETS,
+	SOUND_SKILL_COOL_DOWN,
+	SOUND_SKILL_INVINCIBLE,
+	SOUND_WIN,
+	NUM_SOUND_IDS
+};
+
+//-----------------------------------------------------------------------------------------------
+// When the VoiceManager is over a limit, a sound may only take a voice from a sound of the same
+// or lower priority.
+//
+enum SoundPriority : unsigned char
+{
+	SOUND_PRIORITY_BUMP,			// wall and ship bumps
+	SOUND_PRIORITY_WEAPON,			// shots and skills
+	SOUND_PRIORITY_HIT,				// hits and enemy deaths
+	SOUND_PRIORITY_CRITICAL,		// ship death and respawn, waves, menus, music
+};
+
+//-----------------------------------------------------------------------------------------------
+// m_estimatedSeconds is a hand-measured clip length, used only for files whose length the
+// SoundBank cannot read itself (see SoundBank::GetVoiceSeconds); 0 for everything else.
+//
+struct SoundDefinition
+{
+	SoundId			m_id;
+	char const*		m_path;
+	SoundPriority	m_priority;
+	int				m_maxVoices;
+	float			m_estimatedSeconds;
+};
+
+SoundDefinition const& GetSoundDefinition(SoundId soundId);
+
+class SoundBank
+{
+public:
+	void Load(AudioSystem& audioSystem);
+
+	SoundID GetSound(SoundId soundId) const { return m_sounds[soundId]; }
+	float GetVoiceSeconds(SoundId soundId) const { return m_voiceSeconds[soundId]; }
+
+private:
+	SoundID m_sounds[NUM_SOUND_IDS] = {};
+	float	m_voiceSeconds[NUM_SOUND_IDS] = {};		// clip length: how long a voice counts against the voice limits
+};
@@ -0,0 +1,140 @@
+#include "Game/SpatialGrid.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <math.h>
+
+SpatialGrid::SpatialGrid(Vec2 const& worldMins, Vec2 const& worldMaxs, float cellSize)
+	: m_worldMins(worldMins)
+	, m_cellSize(cellSize)
+{
+	m_inverseCellSize = 1.f / cellSize;
+	m_numCellsX = static_cast<int>(ceilf((worldMaxs.x - worldMins.x) * m_inverseCellSize));
+	m_numCellsY = static_cast<int>(ceilf((worldMaxs.y - worldMins.y) * m_inverseCellSize));
+	m_cellStarts.resize(m_numCellsX * m_numCellsY + 1);
+}
+
+SpatialGrid::~SpatialGrid()
+{
+}
+
+void SpatialGrid::Clear()
+{
+	m_items.clear();
+	m_cellHandles.clear();
+	m_maxHalfExtents = Vec2(0.f, 0.f);
+}
+
+void SpatialGrid::AddItem(int handle, Vec2 const& boundsMins, Vec2 const& boundsMaxs)
+{
+	Vec2 center = (boundsMins + boundsMaxs) * 0.5f;
+	Vec2 halfExtents = (boundsMaxs - boundsMins) * 0.5f;
+
+	if (halfExtents.x > m_maxHalfExtents.x)
+	{
+		m_maxHalfExtents.x = halfExtents.x;
+	}
+	if (halfExtents.y > m_maxHalfExtents.y)
+	{
+		m_maxHalfExtents.y = halfExtents.y;
+	}
+
+	GridItem item;
+	item.m_handle = handle;
+	item.m_cellIndex = GetCellY(center.y) * m_numCellsX + GetCellX(center.x);
+	m_items.push_back(item);
+}
+
+void SpatialGrid::Build()
+{
+	int numCells = m_numCellsX * m_numCellsY;
+	for (int cellIndex = 0; cellIndex <= numCells; ++cellIndex)
+	{
+		m_cellStarts[cellIndex] = 0;
+	}
+
+	// counting sort: count per cell, prefix-sum into starts, then scatter
+	for (int itemIndex = 0; itemIndex < static_cast<int>(m_items.size()); ++itemIndex)
+	{
+		m_cellStarts[m_items[itemIndex].m_cellIndex + 1] += 1;
+	}
+	for (int cellIndex = 0; cellIndex < numCells; ++cellIndex)
+	{
+		m_cellStarts[cellIndex + 1] += m_cellStarts[cellIndex];
+	}
+
+	m_cellHandles.resize(m_items.size());
+	for (int itemIndex = 0; itemIndex < static_cast<int>(m_items.size()); ++itemIndex)
+	{
+		GridItem const& item = m_items[itemIndex];
+		int slot = m_cellStarts[item.m_cellIndex]++;
+		m_cellHandles[slot] = item.m_handle;
+	}
+
+	// the scatter advanced every start to the next cell's start; shift them back
+	for (int cellIndex = numCells; cellIndex > 0; --cellIndex)
+	{
+		m_cellStarts[cellIndex] = m_cellStarts[cellIndex - 1];
+	}
+	m_cellStarts[0] = 0;
+}
+
+void SpatialGrid::QueryItems(Vec2 const& mins, Vec2 const& maxs, std::vector<int>& out_handles) const
+{
+	int minX = GetCellX(mins.x - m_maxHalfExtents.x);
+	int maxX = GetCellX(maxs.x + m_maxHalfExtents.x);
+	int minY = GetCellY(mins.y - m_maxHalfExtents.y);
+	int maxY = GetCellY(maxs.y + m_maxHalfExtents.y);
+
+	for (int cellY = minY; cellY <= maxY; ++cellY)
+	{
+		for (int cellX = minX; cellX <= maxX; ++cellX)
+		{
+			int cellIndex = cellY * m_numCellsX + cellX;
+			for (int slot = m_cellStarts[cellIndex]; slot < m_cellStarts[cellIndex + 1]; ++slot)
+			{
+				out_handles.push_back(m_cellHandles[slot]);
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Valid after Build(). Items are counted in the cell their bounds are centered in.
+//
+int SpatialGrid::GetNumItemsInCell(int cellX, int cellY) const
+{
+	int cellIndex = cellY * m_numCellsX + cellX;
+	return m_cellStarts[cellIndex + 1] - m_cellStarts[cellIndex];
+}
+
+Vec2 SpatialGrid::GetCellCenter(int cellX, int cellY) const
+{
+	return Vec2(m_worldMins.x + (static_cast<float>(cellX) + 0.5f) * m_cellSize, m_worldMins.y + (static_cast<float>(cellY) + 0.5f) * m_cellSize);
+}
+
+int SpatialGrid::GetCellX(float x) const
+{
+	int cellX = static_cast<int>(floorf((x - m_worldMins.x) * m_inverseCellSize));
+	if (cellX < 0)
+	{
+		return 0;
+	}
+	if (cellX >= m_numCellsX)
+	{
+		return m_numCellsX - 1;
+	}
+	return cellX;
+}
+
+int SpatialGrid::GetCellY(float y) const
+{
+	int cellY = static_cast<int>(floorf((y - m_worldMins.y) * m_inverseCellSize));
+	if (cellY < 0)
+	{
+		return 0;
+	}
+	if (cellY >= m_numCellsY)
+	{
+		return m_numCellsY - 1;
+	}
+	return cellY;
+}
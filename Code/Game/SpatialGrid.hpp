@@ -0,0 +1,50 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include <vector>
+
+//-----------------------------------------------------------------------------------------------
+// Uniform grid broadphase over the world. Items are integer handles owned by the caller.
+// Each item is binned once by the center of its bounds, and queries are padded by the largest
+// half-extent seen, so a query never returns the same handle twice and is safe to run from
+// several threads at once after Build().
+//
+class SpatialGrid
+{
+public:
+	SpatialGrid(Vec2 const& worldMins, Vec2 const& worldMaxs, float cellSize);
+	~SpatialGrid();
+
+	void Clear();
+	void AddItem(int handle, Vec2 const& boundsMins, Vec2 const& boundsMaxs);
+	void Build();
+
+	void QueryItems(Vec2 const& mins, Vec2 const& maxs, std::vector<int>& out_handles) const;
+
+	int GetNumItems() const { return static_cast<int>(m_items.size()); }
+	int GetNumCellsX() const { return m_numCellsX; }
+	int GetNumCellsY() const { return m_numCellsY; }
+	int GetNumItemsInCell(int cellX, int cellY) const;
+	Vec2 GetCellCenter(int cellX, int cellY) const;
+
+private:
+	int GetCellX(float x) const;
+	int GetCellY(float y) const;
+
+private:
+	struct GridItem
+	{
+		int m_handle = -1;
+		int m_cellIndex = 0;
+	};
+
+	Vec2	m_worldMins;
+	float	m_cellSize = 1.f;
+	float	m_inverseCellSize = 1.f;
+	int		m_numCellsX = 0;
+	int		m_numCellsY = 0;
+	Vec2	m_maxHalfExtents;
+
+	std::vector<GridItem>	m_items;
+	std::vector<int>		m_cellStarts;
+	std::vector<int>		m_cellHandles;
+};
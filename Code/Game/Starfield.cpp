@@ -0,0 +1,169 @@
+#include "Game/Starfield.hpp"
+#include "Game/BatchTransform.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/MeshLibrary.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include <math.h>
+
+//-----------------------------------------------------------------------------------------------
+// Quarter turns as (cos, sin), picked per tile.
+//
+static Vec2 const s_tileRotations[4] = { Vec2(1.f, 0.f), Vec2(0.f, 1.f), Vec2(-1.f, 0.f), Vec2(0.f, -1.f) };
+
+static unsigned int GetTileHash(int tileX, int tileY)
+{
+	unsigned int hash = (static_cast<unsigned int>(tileX) * 0x8da6b343u) ^ (static_cast<unsigned int>(tileY) * 0xd8163841u) ^ STARFIELD_SEED;
+	hash ^= hash >> 13;
+	hash *= 0x5bd1e995u;
+	hash ^= hash >> 15;
+	return hash;
+}
+
+Starfield::Starfield()
+{
+}
+
+Starfield::~Starfield()
+{
+}
+
+void Starfield::Startup(MeshLibrary const& meshLibrary, Vec2 const& worldSize)
+{
+	m_numTilesX = static_cast<int>(ceilf(worldSize.x / STARFIELD_TILE_SIZE));
+	m_numTilesY = static_cast<int>(ceilf(worldSize.y / STARFIELD_TILE_SIZE));
+
+	Vertex_PCU const* starVerts = meshLibrary.GetVerts(MESH_STAR);
+	int numStarVerts = meshLibrary.GetNumVerts(MESH_STAR);
+	unsigned int const* starIndexes = meshLibrary.GetIndexes(MESH_STAR);
+	int numStarIndexes = meshLibrary.GetNumIndexes(MESH_STAR);
+	m_numVertsPerStar = numStarVerts;
+	m_numIndexesPerStar = numStarIndexes;
+
+	// Stars stay fully inside the tile so a tile's square bounds are also its cull bounds
+	float maxOffset = 0.5f * STARFIELD_TILE_SIZE - STAR_RADIUS;
+	RandomNumberGenerator starRng(STARFIELD_SEED);
+	for (int starIndex = 0; starIndex < STARS_PER_STARFIELD_TILE; ++starIndex)
+	{
+		Vec2 center(starRng.RollRandomFloatInRange(-maxOffset, maxOffset), starRng.RollRandomFloatInRange(-maxOffset, maxOffset));
+		float phase = starRng.RollRandomFloatZeroToOne();
+
+		unsigned int firstVert = static_cast<unsigned int>(m_tileVerts.size());
+		for (int vertIndex = 0; vertIndex < numStarVerts; ++vertIndex)
+		{
+			Vertex_PCU vert = starVerts[vertIndex];
+			vert.m_position.x += center.x;
+			vert.m_position.y += center.y;
+			vert.m_uvTexCoords = Vec2(phase, 0.f);
+			m_tileVerts.push_back(vert);
+		}
+		for (int indexIndex = 0; indexIndex < numStarIndexes; ++indexIndex)
+		{
+			m_tileIndexes.push_back(firstVert + starIndexes[indexIndex]);
+		}
+	}
+
+	int numTileVerts = static_cast<int>(m_tileVerts.size());
+	int numPaddedVerts = GetNumBatchTransformGroups(numTileVerts) * BATCH_TRANSFORM_LANES;
+	m_tileLocalXs.assign(numPaddedVerts, 0.f);
+	m_tileLocalYs.assign(numPaddedVerts, 0.f);
+	for (int vertIndex = 0; vertIndex < numTileVerts; ++vertIndex)
+	{
+		m_tileLocalXs[vertIndex] = m_tileVerts[vertIndex].m_position.x;
+		m_tileLocalYs[vertIndex] = m_tileVerts[vertIndex].m_position.y;
+	}
+	m_twinkleAlphas.resize(numTileVerts);
+}
+
+void Starfield::SetNumStarsPerTile(int numStarsPerTile)
+{
+	m_numStarsPerTile = numStarsPerTile < 0 ? 0 : (numStarsPerTile > STARS_PER_STARFIELD_TILE ? STARS_PER_STARFIELD_TILE : numStarsPerTile);
+}
+
+//-----------------------------------------------------------------------------------------------
+// Draws every tile overlapping viewBounds in one draw. seconds is the game clock time the
+// twinkle is evaluated at. Leaves the renderer in alpha blend mode.
+//
+void Starfield::Render(AABB2 const& viewBounds, double seconds) const
+{
+	AddVisibleTiles(viewBounds);
+	int numTiles = static_cast<int>(m_tileInstances.size());
+	if (numTiles == 0 || m_numStarsPerTile == 0)
+	{
+		return;
+	}
+
+	g_theRenderBackend->SetBlendMode(BlendMode::ALPHA);
+	int numTileVerts = m_numStarsPerTile * m_numVertsPerStar;
+	int numTileIndexes = m_numStarsPerTile * m_numIndexesPerStar;
+
+	ComputeTwinkleAlphas(seconds);
+
+	m_verts.resize(numTiles * numTileVerts);
+	m_indexes.resize(numTiles * numTileIndexes);
+	TransformInstances(m_tileLocalXs.data(), m_tileLocalYs.data(), m_tileVerts.data(), numTileVerts, m_tileInstances.data(), numTiles, m_verts.data());
+
+	for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+	{
+		Vertex_PCU* tileVerts = &m_verts[tileIndex * numTileVerts];
+		for (int vertIndex = 0; vertIndex < numTileVerts; ++vertIndex)
+		{
+			tileVerts[vertIndex].m_color.a = m_twinkleAlphas[vertIndex];
+		}
+
+		unsigned int baseVert = static_cast<unsigned int>(tileIndex * numTileVerts);
+		unsigned int* tileIndexes = &m_indexes[tileIndex * numTileIndexes];
+		for (int indexIndex = 0; indexIndex < numTileIndexes; ++indexIndex)
+		{
+			tileIndexes[indexIndex] = baseVert + m_tileIndexes[indexIndex];
+		}
+	}
+
+	DrawIndexedVertexArray(static_cast<int>(m_verts.size()), m_verts.data(), static_cast<int>(m_indexes.size()), m_indexes.data());
+}
+
+void Starfield::AddVisibleTiles(AABB2 const& viewBounds) const
+{
+	m_tileInstances.clear();
+
+	int minTileX = static_cast<int>(floorf(viewBounds.m_mins.x / STARFIELD_TILE_SIZE));
+	int minTileY = static_cast<int>(floorf(viewBounds.m_mins.y / STARFIELD_TILE_SIZE));
+	int maxTileX = static_cast<int>(floorf(viewBounds.m_maxs.x / STARFIELD_TILE_SIZE));
+	int maxTileY = static_cast<int>(floorf(viewBounds.m_maxs.y / STARFIELD_TILE_SIZE));
+	minTileX = minTileX < 0 ? 0 : minTileX;
+	minTileY = minTileY < 0 ? 0 : minTileY;
+	maxTileX = maxTileX >= m_numTilesX ? m_numTilesX - 1 : maxTileX;
+	maxTileY = maxTileY >= m_numTilesY ? m_numTilesY - 1 : maxTileY;
+
+	for (int tileY = minTileY; tileY <= maxTileY; ++tileY)
+	{
+		for (int tileX = minTileX; tileX <= maxTileX; ++tileX)
+		{
+			unsigned int hash = GetTileHash(tileX, tileY);
+
+			RenderInstance instance;
+			instance.m_position = Vec2((static_cast<float>(tileX) + 0.5f) * STARFIELD_TILE_SIZE, (static_cast<float>(tileY) + 0.5f) * STARFIELD_TILE_SIZE);
+			instance.m_rotation = s_tileRotations[hash & 3];
+			instance.m_scale = (hash & 4) ? Vec2(1.f, -1.f) : Vec2(1.f, 1.f);
+			instance.m_tint = Rgba8(255, 255, 255, 255);
+			m_tileInstances.push_back(instance);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Alpha follows a sine over STAR_TWINKLE_SECONDS, offset by the star's phase. Every copy of the
+// tile shares these alphas.
+//
+void Starfield::ComputeTwinkleAlphas(double seconds) const
+{
+	float cycleFraction = static_cast<float>(fmod(seconds, static_cast<double>(STAR_TWINKLE_SECONDS))) / STAR_TWINKLE_SECONDS;
+	for (int vertIndex = 0; vertIndex < static_cast<int>(m_tileVerts.size()); ++vertIndex)
+	{
+		Vertex_PCU const& vert = m_tileVerts[vertIndex];
+		float twinkle = RangeMapClamped(SinDegrees(360.f * (cycleFraction + vert.m_uvTexCoords.x)), -1.f, 1.f, 0.f, 1.f);
+		m_twinkleAlphas[vertIndex] = static_cast<unsigned char>(static_cast<float>(vert.m_color.a) * twinkle);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "Game/EngineBuildPreferences.hpp"
+#include "Game/RenderCommandList.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include <vector>
+
+class MeshLibrary;
+
+constexpr int NUM_STAR_TRIS = 6;
+constexpr int NUM_STAR_VERTS = 3 * NUM_STAR_TRIS;
+constexpr float STAR_RADIUS = 3.f;
+constexpr float STARFIELD_TILE_SIZE = 200.f;
+constexpr int STARS_PER_STARFIELD_TILE = 8;
+constexpr float STAR_TWINKLE_SECONDS = 1.f;
+constexpr unsigned int STARFIELD_SEED = 4242;
+
+//-----------------------------------------------------------------------------------------------
+// The static background. One square tile of stars is baked at startup into a single vertex and
+// index buffer; each star's twinkle phase is stored in its vertices' u coordinate. The world is
+// covered by copies of that tile, each rotated and mirrored by a hash of its tile coordinates so
+// the repetition does not show. A frame only touches the tiles a view can see, so the cost does
+// not depend on the world size or the total number of stars, and the whole layer is one draw.
+// Each star's vertices and indexes are contiguous in the tile, so drawing fewer stars per tile
+// (a quality knob) just draws a prefix of it.
+//
+// The visible tiles are expanded on the CPU with TransformInstances, and the twinkle alphas are
+// applied to the expanded vertices.
+//
+class Starfield
+{
+public:
+	Starfield();
+	~Starfield();
+
+	void Startup(MeshLibrary const& meshLibrary, Vec2 const& worldSize);
+	void Render(AABB2 const& viewBounds, double seconds) const;
+
+	void SetNumStarsPerTile(int numStarsPerTile);
+	int GetNumStars() const { return m_numTilesX * m_numTilesY * m_numStarsPerTile; }
+
+private:
+	void AddVisibleTiles(AABB2 const& viewBounds) const;
+	void ComputeTwinkleAlphas(double seconds) const;
+
+private:
+	std::vector<Vertex_PCU>				m_tileVerts;
+	std::vector<unsigned int>			m_tileIndexes;
+	std::vector<float>					m_tileLocalXs;
+	std::vector<float>					m_tileLocalYs;
+	int									m_numTilesX = 0;
+	int									m_numTilesY = 0;
+	int									m_numVertsPerStar = 0;
+	int									m_numIndexesPerStar = 0;
+	int									m_numStarsPerTile = STARS_PER_STARFIELD_TILE;
+
+	mutable std::vector<RenderInstance>	m_tileInstances;
+	mutable std::vector<unsigned char>	m_twinkleAlphas;
+	mutable std::vector<Vertex_PCU>		m_verts;
+	mutable std::vector<unsigned int>	m_indexes;
+};
@@ -0,0 +1,196 @@
+#include "Game/TaskGraph.hpp"
+#include "Game/GameCommandBuffer.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+TaskGraph::TaskGraph(int numWorkerThreads)
+{
+	for (int threadIndex = 0; threadIndex < numWorkerThreads; ++threadIndex)
+	{
+		m_workerThreads.push_back(std::thread(&TaskGraph::WorkerThreadMain, this, threadIndex + 1));
+	}
+}
+
+TaskGraph::~TaskGraph()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_isShuttingDown = true;
+	}
+	m_stateChanged.notify_all();
+
+	for (int threadIndex = 0; threadIndex < static_cast<int>(m_workerThreads.size()); ++threadIndex)
+	{
+		m_workerThreads[threadIndex].join();
+	}
+}
+
+int TaskGraph::AddTask(char const* name, TaskResourceMask reads, TaskResourceMask writes, TaskFunction const& function)
+{
+	int newTaskIndex = static_cast<int>(m_tasks.size());
+
+	Task newTask;
+	newTask.m_name = name;
+	newTask.m_reads = reads;
+	newTask.m_writes = writes;
+	newTask.m_function = function;
+
+	for (int taskIndex = 0; taskIndex < newTaskIndex; ++taskIndex)
+	{
+		Task& earlierTask = m_tasks[taskIndex];
+		bool isWriteAfterAccess = ((earlierTask.m_reads | earlierTask.m_writes) & writes) != 0;
+		bool isReadAfterWrite = (earlierTask.m_writes & reads) != 0;
+		if (isWriteAfterAccess || isReadAfterWrite)
+		{
+			newTask.m_dependencies.push_back(taskIndex);
+			earlierTask.m_dependents.push_back(newTaskIndex);
+		}
+	}
+
+	m_tasks.push_back(newTask);
+	return newTaskIndex;
+}
+
+void TaskGraph::Execute()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_readyTasks.clear();
+	for (int taskIndex = 0; taskIndex < static_cast<int>(m_tasks.size()); ++taskIndex)
+	{
+		Task& task = m_tasks[taskIndex];
+		task.m_remainingDependencies = static_cast<int>(task.m_dependencies.size());
+		if (task.m_remainingDependencies == 0)
+		{
+			m_readyTasks.push_back(taskIndex);
+		}
+	}
+	m_numTasksRemaining = static_cast<int>(m_tasks.size());
+	m_executeStartSeconds = GetCurrentTimeSeconds();
+	m_stateChanged.notify_all();
+
+	while (m_numTasksRemaining > 0)
+	{
+		if (!RunOneReadyTask(0, lock))
+		{
+			m_stateChanged.wait(lock);
+		}
+	}
+
+	m_lastTotalSeconds = GetCurrentTimeSeconds() - m_executeStartSeconds;
+}
+
+void TaskGraph::WorkerThreadMain(int workerIndex)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_isShuttingDown)
+	{
+		if (!RunOneReadyTask(workerIndex, lock))
+		{
+			m_stateChanged.wait(lock);
+		}
+	}
+}
+
+bool TaskGraph::RunOneReadyTask(int workerIndex, std::unique_lock<std::mutex>& lock)
+{
+	if (m_readyTasks.empty())
+	{
+		return false;
+	}
+
+	int taskIndex = m_readyTasks.back();
+	m_readyTasks.pop_back();
+	Task& task = m_tasks[taskIndex];
+
+	lock.unlock();
+	task.m_startSeconds = GetCurrentTimeSeconds() - m_executeStartSeconds;
+	int outerTaskIndex = GetSimTaskIndex();
+	SetSimTaskIndex(taskIndex);
+	task.m_function();
+	SetSimTaskIndex(outerTaskIndex);
+	task.m_endSeconds = GetCurrentTimeSeconds() - m_executeStartSeconds;
+	task.m_workerIndex = workerIndex;
+	lock.lock();
+
+	m_numTasksRemaining -= 1;
+	for (int dependentIndex = 0; dependentIndex < static_cast<int>(task.m_dependents.size()); ++dependentIndex)
+	{
+		Task& dependent = m_tasks[task.m_dependents[dependentIndex]];
+		dependent.m_remainingDependencies -= 1;
+		if (dependent.m_remainingDependencies == 0)
+		{
+			m_readyTasks.push_back(task.m_dependents[dependentIndex]);
+		}
+	}
+	m_stateChanged.notify_all();
+	return true;
+}
+
+std::vector<int> TaskGraph::GetLastCriticalPath() const
+{
+	// tasks only depend on earlier tasks, so insertion order is already a topological order
+	int numTasks = static_cast<int>(m_tasks.size());
+	std::vector<double> pathSeconds(numTasks, 0.0);
+	std::vector<int> pathPrevious(numTasks, -1);
+
+	int lastOnPath = -1;
+	for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+	{
+		Task const& task = m_tasks[taskIndex];
+		for (int depIndex = 0; depIndex < static_cast<int>(task.m_dependencies.size()); ++depIndex)
+		{
+			int dependency = task.m_dependencies[depIndex];
+			if (pathSeconds[dependency] > pathSeconds[taskIndex])
+			{
+				pathSeconds[taskIndex] = pathSeconds[dependency];
+				pathPrevious[taskIndex] = dependency;
+			}
+		}
+		pathSeconds[taskIndex] += task.m_endSeconds - task.m_startSeconds;
+
+		if (lastOnPath < 0 || pathSeconds[taskIndex] > pathSeconds[lastOnPath])
+		{
+			lastOnPath = taskIndex;
+		}
+	}
+
+	std::vector<int> criticalPath;
+	for (int taskIndex = lastOnPath; taskIndex >= 0; taskIndex = pathPrevious[taskIndex])
+	{
+		criticalPath.insert(criticalPath.begin(), taskIndex);
+	}
+	return criticalPath;
+}
+
+double TaskGraph::GetLastCriticalPathSeconds() const
+{
+	double criticalSeconds = 0.0;
+	std::vector<int> criticalPath = GetLastCriticalPath();
+	for (int pathIndex = 0; pathIndex < static_cast<int>(criticalPath.size()); ++pathIndex)
+	{
+		Task const& task = m_tasks[criticalPath[pathIndex]];
+		criticalSeconds += task.m_endSeconds - task.m_startSeconds;
+	}
+	return criticalSeconds;
+}
+
+std::string TaskGraph::GetLastProfileReport() const
+{
+	std::string report = Stringf("%d tasks on %d workers, %.3f ms total\n", GetNumTasks(), GetNumWorkers(), m_lastTotalSeconds * 1000.0);
+	for (int taskIndex = 0; taskIndex < static_cast<int>(m_tasks.size()); ++taskIndex)
+	{
+		Task const& task = m_tasks[taskIndex];
+		report += Stringf("  %-24s worker %d  start %.3f ms  took %.3f ms\n", task.m_name.c_str(), task.m_workerIndex,
+						  task.m_startSeconds * 1000.0, (task.m_endSeconds - task.m_startSeconds) * 1000.0);
+	}
+
+	std::vector<int> criticalPath = GetLastCriticalPath();
+	report += Stringf("Critical path (%.3f ms):", GetLastCriticalPathSeconds() * 1000.0);
+	for (int pathIndex = 0; pathIndex < static_cast<int>(criticalPath.size()); ++pathIndex)
+	{
+		report += (pathIndex == 0) ? " " : " -> ";
+		report += m_tasks[criticalPath[pathIndex]].m_name;
+	}
+	return report;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef unsigned int TaskResourceMask;
+typedef std::function<void()> TaskFunction;
+
+//-----------------------------------------------------------------------------------------------
+// Resources a frame task may read or write. Two tasks are ordered (in the order they were added)
+// whenever one writes something the other reads or writes; everything else may overlap.
+//
+enum TaskResource : TaskResourceMask
+{
+	TASK_RESOURCE_NONE			= 0,
+	TASK_RESOURCE_SHIPS			= 1 << 0,
+	TASK_RESOURCE_BULLETS		= 1 << 1,
+	TASK_RESOURCE_ASTEROIDS		= 1 << 2,
+	TASK_RESOURCE_BEETLES		= 1 << 3,
+	TASK_RESOURCE_WASPS			= 1 << 4,
+	TASK_RESOURCE_DEBRIS		= 1 << 5,
+	TASK_RESOURCE_CAMERAS		= 1 << 7,
+	TASK_RESOURCE_WAVE			= 1 << 8,
+	TASK_RESOURCE_RNG			= 1 << 10,
+	TASK_RESOURCE_ENEMY_GRID	= 1 << 11,
+	TASK_RESOURCE_ENEMIES		= TASK_RESOURCE_ASTEROIDS | TASK_RESOURCE_BEETLES | TASK_RESOURCE_WASPS,
+	TASK_RESOURCE_ALL			= 0xFFFFFFFFu,
+};
+
+//-----------------------------------------------------------------------------------------------
+// A fixed graph of frame tasks with dependencies derived from declared read/write sets.
+// The graph is built once and executed every tick across a small pool of workers; the calling
+// thread takes part as worker 0. Each execution records per-task timings so the critical path
+// of the last run can be reported.
+//
+class TaskGraph
+{
+public:
+	TaskGraph(int numWorkerThreads);
+	~TaskGraph();
+
+	int AddTask(char const* name, TaskResourceMask reads, TaskResourceMask writes, TaskFunction const& function);
+	void Execute();
+
+	int GetNumWorkers() const { return static_cast<int>(m_workerThreads.size()) + 1; }
+	int GetNumTasks() const { return static_cast<int>(m_tasks.size()); }
+	double GetLastTotalSeconds() const { return m_lastTotalSeconds; }
+	double GetLastCriticalPathSeconds() const;
+	std::vector<int> GetLastCriticalPath() const;
+	std::string GetLastProfileReport() const;
+
+private:
+	struct Task
+	{
+		std::string			m_name;
+		TaskResourceMask	m_reads = TASK_RESOURCE_NONE;
+		TaskResourceMask	m_writes = TASK_RESOURCE_NONE;
+		TaskFunction		m_function;
+		std::vector<int>	m_dependencies;
+		std::vector<int>	m_dependents;
+		int					m_remainingDependencies = 0;
+		double				m_startSeconds = 0.0;
+		double				m_endSeconds = 0.0;
+		int					m_workerIndex = 0;
+	};
+
+	void WorkerThreadMain(int workerIndex);
+	bool RunOneReadyTask(int workerIndex, std::unique_lock<std::mutex>& lock);
+
+private:
+	std::vector<Task>			m_tasks;
+	std::vector<std::thread>	m_workerThreads;
+
+	std::mutex					m_mutex;
+	std::condition_variable		m_stateChanged;
+	std::vector<int>			m_readyTasks;
+	int							m_numTasksRemaining = 0;
+	bool						m_isShuttingDown = false;
+
+	double						m_executeStartSeconds = 0.0;
+	double						m_lastTotalSeconds = 0.0;
+};
@@ -0,0 +1,137 @@
+#include "Game/VoiceManager.hpp"
+#include <math.h>
+
+constexpr int NO_VOICE = -1;
+
+void VoiceManager::PlaySound(AudioSystem& audioSystem, SoundBank const& soundBank, SoundId sound, float volume, double seconds)
+{
+	ExpireVoices(seconds);
+
+	SoundDefinition const& definition = GetSoundDefinition(sound);
+	int latestVoiceIndex = NO_VOICE;
+	for (int voiceIndex = 0; voiceIndex < MAX_SFX_VOICES; ++voiceIndex)
+	{
+		Voice const& voice = m_voices[voiceIndex];
+		if (voice.m_isActive && voice.m_sound == sound && (latestVoiceIndex == NO_VOICE || voice.m_startSeconds > m_voices[latestVoiceIndex].m_startSeconds))
+		{
+			latestVoiceIndex = voiceIndex;
+		}
+	}
+
+	if (latestVoiceIndex != NO_VOICE && seconds - m_voices[latestVoiceIndex].m_startSeconds <= static_cast<double>(SOUND_COALESCE_SECONDS))
+	{
+		Voice& voice = m_voices[latestVoiceIndex];
+		float coalescedVolume = sqrtf(voice.m_volume * voice.m_volume + volume * volume);
+		float maxVolume = voice.m_startVolume * MAX_COALESCED_VOLUME_SCALE;
+		coalescedVolume = coalescedVolume > maxVolume ? maxVolume : coalescedVolume;
+		if (coalescedVolume > voice.m_volume)
+		{
+			voice.m_volume = coalescedVolume;
+			audioSystem.SetSoundPlaybackVolume(voice.m_playback, coalescedVolume);
+		}
+		++m_numCoalesced;
+		return;
+	}
+
+	int voiceIndex = NO_VOICE;
+	if (m_numVoicesOfSound[sound] >= definition.m_maxVoices)
+	{
+		voiceIndex = FindVoiceToSteal(sound, definition.m_priority, volume);
+	}
+	else if (m_numActiveVoices >= MAX_SFX_VOICES)
+	{
+		voiceIndex = FindVoiceToSteal(NUM_SOUND_IDS, definition.m_priority, volume);
+	}
+	else
+	{
+		voiceIndex = 0;
+		while (m_voices[voiceIndex].m_isActive)
+		{
+			++voiceIndex;
+		}
+	}
+
+	if (voiceIndex == NO_VOICE)
+	{
+		++m_numDropped;
+		return;
+	}
+
+	Voice& voice = m_voices[voiceIndex];
+	if (voice.m_isActive)
+	{
+		audioSystem.StopSound(voice.m_playback);
+		--m_numVoicesOfSound[voice.m_sound];
+		--m_numActiveVoices;
+		++m_numStolen;
+	}
+
+	voice.m_playback = audioSystem.StartSound(soundBank.GetSound(sound), false, volume);
+	voice.m_sound = sound;
+	voice.m_volume = volume;
+	voice.m_startVolume = volume;
+	voice.m_startSeconds = seconds;
+	voice.m_endSeconds = seconds + static_cast<double>(soundBank.GetVoiceSeconds(sound));
+	voice.m_isActive = true;
+	++m_numVoicesOfSound[sound];
+	++m_numActiveVoices;
+	++m_numStarted;
+	if (m_numActiveVoices > m_peakVoices)
+	{
+		m_peakVoices = m_numActiveVoices.load();
+	}
+}
+
+void VoiceManager::ExpireVoices(double seconds)
+{
+	for (int voiceIndex = 0; voiceIndex < MAX_SFX_VOICES; ++voiceIndex)
+	{
+		Voice& voice = m_voices[voiceIndex];
+		if (voice.m_isActive && voice.m_endSeconds <= seconds)
+		{
+			voice.m_isActive = false;
+			--m_numVoicesOfSound[voice.m_sound];
+			--m_numActiveVoices;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+// Looks only at voices of onlySound, or at every voice when it is NUM_SOUND_IDS. Returns
+// NO_VOICE when every candidate outranks a new sound of this priority and volume.
+//
+int VoiceManager::FindVoiceToSteal(SoundId onlySound, SoundPriority priority, float volume) const
+{
+	int victimIndex = NO_VOICE;
+	for (int voiceIndex = 0; voiceIndex < MAX_SFX_VOICES; ++voiceIndex)
+	{
+		Voice const& voice = m_voices[voiceIndex];
+		if (!voice.m_isActive || (onlySound != NUM_SOUND_IDS && voice.m_sound != onlySound))
+		{
+			continue;
+		}
+
+		SoundPriority voicePriority = GetSoundDefinition(voice.m_sound).m_priority;
+		if (victimIndex == NO_VOICE)
+		{
+			victimIndex = voiceIndex;
+			continue;
+		}
+		SoundPriority victimPriority = GetSoundDefinition(m_voices[victimIndex].m_sound).m_priority;
+		if (voicePriority < victimPriority || (voicePriority == victimPriority && voice.m_volume < m_voices[victimIndex].m_volume))
+		{
+			victimIndex = voiceIndex;
+		}
+	}
+
+	if (victimIndex == NO_VOICE)
+	{
+		return NO_VOICE;
+	}
+	SoundPriority victimPriority = GetSoundDefinition(m_voices[victimIndex].m_sound).m_priority;
+	if (victimPriority > priority || (victimPriority == priority && m_voices[victimIndex].m_volume > volume))
+	{
+		return NO_VOICE;
+	}
+	return victimIndex;
+}
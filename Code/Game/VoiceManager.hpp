@@ -0,0 +1,61 @@
+#pragma once
+#include "Game/SoundBank.hpp"
+#include <atomic>
+
+constexpr int MAX_SFX_VOICES = 24;					// one-shot voices playing at once, across all sounds
+constexpr float SOUND_COALESCE_SECONDS = 0.05f;		// a repeat within this long of a voice's start joins that voice
+constexpr float MAX_COALESCED_VOLUME_SCALE = 2.f;	// a joined voice gets at most this times the volume it started at
+
+//-----------------------------------------------------------------------------------------------
+// Budgets the one-shot voices the AudioThread starts, so a burst of hits in one frame costs a
+// few FMOD voices rather than dozens.
+//
+// A sound started again within SOUND_COALESCE_SECONDS of its latest voice is merged into that
+// voice: its volume becomes the power sum of the two, up to MAX_COALESCED_VOLUME_SCALE times the
+// first trigger. Otherwise a new voice needs a free slot under both the sound's m_maxVoices and
+// MAX_SFX_VOICES. When a limit is hit, the quietest voice of the lowest priority in the way is
+// stopped for the new one, unless it outranks the new sound (higher priority, or same priority
+// and louder), in which case the new sound is dropped.
+//
+// Voices are freed once their clip length has passed; the AudioSystem does not report when a
+// playback ends. Controlled sounds (music) never go through here. Used only on the audio thread;
+// the stats are atomics so the console can read them from the main thread.
+//
+class VoiceManager
+{
+public:
+	void PlaySound(AudioSystem& audioSystem, SoundBank const& soundBank, SoundId sound, float volume, double seconds);
+
+	int GetNumActiveVoices() const { return m_numActiveVoices; }
+	int GetPeakVoices() const { return m_peakVoices; }
+	int GetNumStarted() const { return m_numStarted; }
+	int GetNumCoalesced() const { return m_numCoalesced; }
+	int GetNumStolen() const { return m_numStolen; }
+	int GetNumDropped() const { return m_numDropped; }
+
+private:
+	struct Voice
+	{
+		SoundPlaybackID	m_playback = 0;
+		SoundId			m_sound = SOUND_BACK;
+		float			m_volume = 0.f;
+		float			m_startVolume = 0.f;
+		double			m_startSeconds = 0.0;
+		double			m_endSeconds = 0.0;
+		bool			m_isActive = false;
+	};
+
+	void ExpireVoices(double seconds);
+	int FindVoiceToSteal(SoundId onlySound, SoundPriority priority, float volume) const;
+
+private:
+	Voice				m_voices[MAX_SFX_VOICES];
+	int					m_numVoicesOfSound[NUM_SOUND_IDS] = {};
+
+	std::atomic<int>	m_numActiveVoices{ 0 };
+	std::atomic<int>	m_peakVoices{ 0 };
+	std::atomic<int>	m_numStarted{ 0 };
+	std::atomic<int>	m_numCoalesced{ 0 };
+	std::atomic<int>	m_numStolen{ 0 };
+	std::atomic<int>	m_numDropped{ 0 };
+};
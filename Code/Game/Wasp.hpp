@@ -15,19 +15,10 @@ public:
 	~Wasp();
 
 	virtual void Update(float deltaSeconds) override;
-	virtual void Render() const override;
-	virtual void DebugRender() const override;
+	virtual void ExtractRenderProxies(RenderSnapshot& snapshot) const override;
+	virtual void ExtractDebugShapes(DebugShapeList& debugShapes) const override;
 	virtual void Die() override;
 
 	void HandleBeHitted(float deltaSeconds);
 	void UpdateOrientationDegAndVel(float deltaSeconds);
-	void RenderWasp() const;
-	void RenderHealthBar() const;
-
-private:
-	void InitializeLocalVerts();
-
-private:
-	Vertex_PCU m_localVerts[NUM_WASP_VERTS];
-	
 };
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "Tests/TestCommon.hpp"
+#include "Game/RenderBackend.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <stdio.h>
+
+RenderBackend* g_theRenderBackend = nullptr;
+
+//-----------------------------------------------------------------------------------------------
+// Headless checks for the game code that has a scalar reference or a known-good result. Runs
+// from the Run folder after every build of this project; any failure fails the build.
+//
+int main(int argc, char** argv)
+{
+	UNUSED(argc);
+	UNUSED(argv);
+
+	int numFailures = 0;
+	numFailures += RunBatchTransformTests();
+	numFailures += RunSoftwareRasterizerTests();
+
+	if (numFailures > 0)
+	{
+		printf("Tests: %d check(s) FAILED\n", numFailures);
+		return 1;
+	}
+	printf("Tests: all passed\n");
+	return 0;
+}
@@ -0,0 +1,185 @@
+#include "Tests/TestCommon.hpp"
+#include "Game/BatchTransform.hpp"
+#include "Game/RenderCommandList.hpp"
+#include "Engine/Core/Time.hpp"
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+constexpr int TRANSFORM_TEST_MAX_GROUPS = 10;		// past every unrolled count into the run-time loop
+constexpr int TRANSFORM_TEST_INSTANCES = 64;
+constexpr int TRANSFORM_BENCH_INSTANCES = 10000;
+constexpr int TRANSFORM_BENCH_RUNS = 5;
+
+//-----------------------------------------------------------------------------------------------
+// A mesh with numVerts distinct positions, colors and UVs, and its local positions split and
+// zero-padded to whole groups the way MeshLibrary lays them out.
+//
+struct TransformTestMesh
+{
+	std::vector<Vertex_PCU>	m_verts;
+	std::vector<float>		m_localXs;
+	std::vector<float>		m_localYs;
+};
+
+static TransformTestMesh MakeTestMesh(int numVerts, std::mt19937& random)
+{
+	std::uniform_real_distribution<float> positionDistribution(-4.f, 4.f);
+	std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+	TransformTestMesh mesh;
+	int numPaddedVerts = GetNumBatchTransformGroups(numVerts) * BATCH_TRANSFORM_LANES;
+	mesh.m_localXs.resize(numPaddedVerts, 0.f);
+	mesh.m_localYs.resize(numPaddedVerts, 0.f);
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		Rgba8 color(static_cast<unsigned char>(byteDistribution(random)), static_cast<unsigned char>(byteDistribution(random)),
+					static_cast<unsigned char>(byteDistribution(random)), static_cast<unsigned char>(byteDistribution(random)));
+		Vec3 position(positionDistribution(random), positionDistribution(random), 0.f);
+		Vec2 uvTexCoords(static_cast<float>(vertIndex) / static_cast<float>(numVerts), 0.5f);
+		mesh.m_verts.push_back(Vertex_PCU(position, color, uvTexCoords));
+		mesh.m_localXs[vertIndex] = position.x;
+		mesh.m_localYs[vertIndex] = position.y;
+	}
+	return mesh;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Every other instance has an opaque white tint, so both the tinted and the untinted paths run.
+//
+static std::vector<RenderInstance> MakeTestInstances(int numInstances, std::mt19937& random)
+{
+	std::uniform_real_distribution<float> positionDistribution(0.f, 200.f);
+	std::uniform_real_distribution<float> radiansDistribution(0.f, 6.2831853f);
+	std::uniform_real_distribution<float> scaleDistribution(0.25f, 3.f);
+	std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+	std::vector<RenderInstance> instances(numInstances);
+	for (int instanceIndex = 0; instanceIndex < numInstances; ++instanceIndex)
+	{
+		RenderInstance& instance = instances[instanceIndex];
+		float radians = radiansDistribution(random);
+		instance.m_position = Vec2(positionDistribution(random), positionDistribution(random));
+		instance.m_rotation = Vec2(cosf(radians), sinf(radians));
+		instance.m_scale = Vec2(scaleDistribution(random), scaleDistribution(random));
+		instance.m_tint = Rgba8(255, 255, 255, 255);
+		if (instanceIndex % 2 == 1)
+		{
+			instance.m_tint = Rgba8(static_cast<unsigned char>(byteDistribution(random)), static_cast<unsigned char>(byteDistribution(random)),
+									static_cast<unsigned char>(byteDistribution(random)), static_cast<unsigned char>(byteDistribution(random)));
+		}
+	}
+	return instances;
+}
+
+static bool AreVertsIdentical(Vertex_PCU const& a, Vertex_PCU const& b)
+{
+	return a.m_position.x == b.m_position.x && a.m_position.y == b.m_position.y && a.m_position.z == b.m_position.z &&
+		   a.m_color == b.m_color && a.m_uvTexCoords.x == b.m_uvTexCoords.x && a.m_uvTexCoords.y == b.m_uvTexCoords.y;
+}
+
+//-----------------------------------------------------------------------------------------------
+// TransformInstances against ExpandInstance for every mesh size up to TRANSFORM_TEST_MAX_GROUPS
+// groups, so each group count (unrolled or not) is run with each number of lanes used in its
+// last group. Results must match bit for bit, and nothing past the last instance may be written.
+//
+static int TestTransformMatchesExpand()
+{
+	std::mt19937 random(1234u);
+	Vertex_PCU canary(Vec3(-12345.f, -12345.f, -12345.f), Rgba8(1, 2, 3, 4), Vec2(-1.f, -1.f));
+
+	int numFailures = 0;
+	for (int numVerts = 1; numVerts <= TRANSFORM_TEST_MAX_GROUPS * BATCH_TRANSFORM_LANES; ++numVerts)
+	{
+		TransformTestMesh mesh = MakeTestMesh(numVerts, random);
+		std::vector<RenderInstance> instances = MakeTestInstances(TRANSFORM_TEST_INSTANCES, random);
+		int numOutVerts = numVerts * TRANSFORM_TEST_INSTANCES;
+
+		std::vector<Vertex_PCU> expectedVerts(numOutVerts);
+		for (int instanceIndex = 0; instanceIndex < TRANSFORM_TEST_INSTANCES; ++instanceIndex)
+		{
+			ExpandInstance(mesh.m_verts.data(), numVerts, instances[instanceIndex], &expectedVerts[instanceIndex * numVerts]);
+		}
+
+		std::vector<Vertex_PCU> batchVerts(numOutVerts + 1, canary);
+		TransformInstances(mesh.m_localXs.data(), mesh.m_localYs.data(), mesh.m_verts.data(), numVerts,
+						   instances.data(), TRANSFORM_TEST_INSTANCES, batchVerts.data());
+
+		for (int vertIndex = 0; vertIndex < numOutVerts; ++vertIndex)
+		{
+			if (!AreVertsIdentical(expectedVerts[vertIndex], batchVerts[vertIndex]))
+			{
+				Vertex_PCU const& expected = expectedVerts[vertIndex];
+				Vertex_PCU const& actual = batchVerts[vertIndex];
+				printf("FAILED TransformMatchesExpand: %d verts (%d groups), instance %d vert %d: expected (%.9g, %.9g) %d,%d,%d,%d, got (%.9g, %.9g) %d,%d,%d,%d\n",
+					   numVerts, GetNumBatchTransformGroups(numVerts), vertIndex / numVerts, vertIndex % numVerts,
+					   expected.m_position.x, expected.m_position.y, expected.m_color.r, expected.m_color.g, expected.m_color.b, expected.m_color.a,
+					   actual.m_position.x, actual.m_position.y, actual.m_color.r, actual.m_color.g, actual.m_color.b, actual.m_color.a);
+				++numFailures;
+				break;
+			}
+		}
+		if (!AreVertsIdentical(batchVerts[numOutVerts], canary))
+		{
+			printf("FAILED TransformMatchesExpand: %d verts wrote past the last instance\n", numVerts);
+			++numFailures;
+		}
+	}
+	return numFailures;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Not a check: best of a few runs of the scalar loop and the batched kernel, for a mesh size per
+// unrolled group count and a couple of larger ones.
+//
+static void BenchTransform()
+{
+	int const benchVertCounts[] = { 3, 6, 12, 16, 20, 36 };
+	std::mt19937 random(5678u);
+	std::vector<RenderInstance> instances = MakeTestInstances(TRANSFORM_BENCH_INSTANCES, random);
+
+	printf("BenchTransform: %d instances, best of %d\n", TRANSFORM_BENCH_INSTANCES, TRANSFORM_BENCH_RUNS);
+	for (int numVerts : benchVertCounts)
+	{
+		TransformTestMesh mesh = MakeTestMesh(numVerts, random);
+		std::vector<Vertex_PCU> outVerts(numVerts * TRANSFORM_BENCH_INSTANCES);
+
+		double bestScalarSeconds = 0.0;
+		double bestBatchSeconds = 0.0;
+		for (int runIndex = 0; runIndex < TRANSFORM_BENCH_RUNS; ++runIndex)
+		{
+			double startSeconds = GetCurrentTimeSeconds();
+			for (int instanceIndex = 0; instanceIndex < TRANSFORM_BENCH_INSTANCES; ++instanceIndex)
+			{
+				ExpandInstance(mesh.m_verts.data(), numVerts, instances[instanceIndex], &outVerts[instanceIndex * numVerts]);
+			}
+			double scalarSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+			startSeconds = GetCurrentTimeSeconds();
+			TransformInstances(mesh.m_localXs.data(), mesh.m_localYs.data(), mesh.m_verts.data(), numVerts,
+							   instances.data(), TRANSFORM_BENCH_INSTANCES, outVerts.data());
+			double batchSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+			if (runIndex == 0 || scalarSeconds < bestScalarSeconds)
+			{
+				bestScalarSeconds = scalarSeconds;
+			}
+			if (runIndex == 0 || batchSeconds < bestBatchSeconds)
+			{
+				bestBatchSeconds = batchSeconds;
+			}
+		}
+
+		printf("  %2d verts (%d groups): scalar %.3f ms, batch %.3f ms, x%.2f\n", numVerts, GetNumBatchTransformGroups(numVerts),
+			   bestScalarSeconds * 1000.0, bestBatchSeconds * 1000.0, bestScalarSeconds / fmax(bestBatchSeconds, 1e-9));
+	}
+}
+
+int RunBatchTransformTests()
+{
+	int numFailures = TestTransformMatchesExpand();
+	BenchTransform();
+	return numFailures;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+//-----------------------------------------------------------------------------------------------
+// Each group of tests prints every failed check and returns how many there were.
+//
+int RunBatchTransformTests();
+int RunSoftwareRasterizerTests();
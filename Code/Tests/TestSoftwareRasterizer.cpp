@@ -0,0 +1,223 @@
+#include "Tests/TestCommon.hpp"
+#include "Game/SoftwareRasterizer.hpp"
+#include "Game/RenderCommandList.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include <fstream>
+#include <stdio.h>
+#include <vector>
+
+constexpr int GOLDEN_FRAME_WIDTH = 256;
+constexpr int GOLDEN_FRAME_HEIGHT = 128;
+constexpr int GOLDEN_MAX_CHANNEL_ERROR = 1;		// smooth shading may round differently across compilers
+char const* const GOLDEN_IMAGE_PATH = "Data/Tests/SoftwareRasterizerGolden.tga";
+char const* const GOLDEN_ACTUAL_PATH = "Data/Tests/SoftwareRasterizerActual.tga";
+
+//-----------------------------------------------------------------------------------------------
+// The player ship shape from MeshLibrary, as a plain triangle list.
+//
+static Vertex_PCU const s_testShipVerts[] =
+{
+	Vertex_PCU(Vec3(2.f, 1.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(0.f, 2.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(-2.f, 1.f, 0.f), Rgba8(255, 255, 255)),
+	Vertex_PCU(Vec3(0.f, 1.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(-2.f, 1.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(-2.f, -1.f, 0.f), Rgba8(255, 255, 255)),
+	Vertex_PCU(Vec3(0.f, 1.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(-2.f, -1.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(0.f, -1.f, 0.f), Rgba8(255, 255, 255)),
+	Vertex_PCU(Vec3(1.f, 0.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(0.f, 1.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(0.f, -1.f, 0.f), Rgba8(255, 255, 255)),
+	Vertex_PCU(Vec3(2.f, -1.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(-2.f, -1.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(0.f, -2.f, 0.f), Rgba8(255, 255, 255)),
+};
+constexpr int NUM_TEST_SHIP_VERTS = sizeof(s_testShipVerts) / sizeof(s_testShipVerts[0]);
+
+//-----------------------------------------------------------------------------------------------
+// One view of a fixed two-player frame: ships, a smooth-shaded translucent triangle, additive
+// quads, an indexed translucent quad whose diagonal must not blend twice, a textured draw that
+// must be skipped, and a triangle reaching past the view that its viewport has to clip.
+// Rotations are exact (cos, sin) pairs so no math library call feeds the image.
+//
+static void DrawGoldenView(SoftwareRasterizer& rasterizer, ViewportData const& viewport, Vec2 const& cameraMins)
+{
+	Camera camera;
+	camera.SetOrthographicView(cameraMins, cameraMins + Vec2(100.f, 100.f));
+	rasterizer.SetViewport(viewport);
+	rasterizer.BeginCamera(camera);
+	rasterizer.BindTexture(nullptr);
+
+	RenderInstance ships[3];
+	ships[0].m_position = Vec2(20.f, 25.f);
+	ships[0].m_rotation = Vec2(0.6f, 0.8f);
+	ships[0].m_scale = Vec2(4.f, 4.f);
+	ships[0].m_tint = Rgba8(255, 255, 255, 255);
+	ships[1].m_position = Vec2(55.f, 70.f);
+	ships[1].m_rotation = Vec2(0.f, 1.f);
+	ships[1].m_scale = Vec2(6.f, 3.f);
+	ships[1].m_tint = Rgba8(90, 200, 255, 255);
+	ships[2].m_position = Vec2(80.f, 30.f);
+	ships[2].m_rotation = Vec2(-0.8f, 0.6f);
+	ships[2].m_scale = Vec2(5.f, 5.f);
+	ships[2].m_tint = Rgba8(255, 120, 40, 160);
+	rasterizer.SetBlendMode(BlendMode::ALPHA);
+	for (RenderInstance const& ship : ships)
+	{
+		Vertex_PCU shipVerts[NUM_TEST_SHIP_VERTS];
+		ExpandInstance(s_testShipVerts, NUM_TEST_SHIP_VERTS, ship, shipVerts);
+		rasterizer.DrawVertexArray(NUM_TEST_SHIP_VERTS, shipVerts);
+	}
+
+	Vertex_PCU const shadedVerts[] =
+	{
+		Vertex_PCU(Vec3(10.f, 90.f, 0.f), Rgba8(255, 0, 0, 200)),
+		Vertex_PCU(Vec3(45.f, 40.f, 0.f), Rgba8(0, 255, 0, 120)),
+		Vertex_PCU(Vec3(90.f, 95.f, 0.f), Rgba8(0, 0, 255, 60)),
+	};
+	rasterizer.DrawVertexArray(3, shadedVerts);
+
+	Vertex_PCU const quadVerts[] =
+	{
+		Vertex_PCU(Vec3(30.f, 5.f, 0.f), Rgba8(255, 255, 0, 128)),
+		Vertex_PCU(Vec3(70.f, 5.f, 0.f), Rgba8(255, 255, 0, 128)),
+		Vertex_PCU(Vec3(70.f, 45.f, 0.f), Rgba8(255, 255, 0, 128)),
+		Vertex_PCU(Vec3(30.f, 45.f, 0.f), Rgba8(255, 255, 0, 128)),
+	};
+	unsigned int const quadIndexes[] = { 0, 1, 2, 0, 2, 3 };
+	rasterizer.DrawIndexedVertexArray(4, quadVerts, 6, quadIndexes);
+
+	Vertex_PCU const clippedVerts[] =
+	{
+		Vertex_PCU(Vec3(85.f, 60.f, 0.f), Rgba8(255, 0, 255, 255)),
+		Vertex_PCU(Vec3(140.f, 80.f, 0.f), Rgba8(255, 0, 255, 255)),
+		Vertex_PCU(Vec3(85.f, 100.f, 0.f), Rgba8(255, 0, 255, 255)),
+	};
+	rasterizer.DrawVertexArray(3, clippedVerts);
+
+	rasterizer.SetBlendMode(BlendMode::ADDITIVE);
+	Vertex_PCU const glowVerts[] =
+	{
+		Vertex_PCU(Vec3(40.f, 50.f, 0.f), Rgba8(60, 60, 255, 255)), Vertex_PCU(Vec3(75.f, 50.f, 0.f), Rgba8(60, 60, 255, 255)), Vertex_PCU(Vec3(75.f, 85.f, 0.f), Rgba8(60, 60, 255, 255)),
+		Vertex_PCU(Vec3(50.f, 60.f, 0.f), Rgba8(200, 60, 0, 200)), Vertex_PCU(Vec3(95.f, 60.f, 0.f), Rgba8(200, 60, 0, 200)), Vertex_PCU(Vec3(50.f, 98.f, 0.f), Rgba8(200, 60, 0, 200)),
+	};
+	rasterizer.DrawVertexArray(6, glowVerts);
+
+	// only compared against null; the rasterizer never samples it
+	Texture const* fakeTexture = reinterpret_cast<Texture const*>(&camera);
+	rasterizer.BindTexture(fakeTexture);
+	Vertex_PCU const texturedVerts[] =
+	{
+		Vertex_PCU(Vec3(0.f, 0.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(100.f, 0.f, 0.f), Rgba8(255, 255, 255)), Vertex_PCU(Vec3(100.f, 100.f, 0.f), Rgba8(255, 255, 255)),
+	};
+	rasterizer.DrawVertexArray(3, texturedVerts);
+	rasterizer.BindTexture(nullptr);
+
+	rasterizer.EndCamera(camera);
+}
+
+//-----------------------------------------------------------------------------------------------
+// Reads the uncompressed 32-bit, top-left origin TGA that SoftwareRasterizer::WriteTGA writes.
+//
+static bool ReadGoldenTGA(char const* filePath, int& out_width, int& out_height, std::vector<Rgba8>& out_pixels)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	unsigned char header[18] = {};
+	file.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (!file || header[2] != 2 || header[16] != 32 || (header[17] & 0x20) == 0)
+	{
+		return false;
+	}
+
+	out_width = header[12] | (header[13] << 8);
+	out_height = header[14] | (header[15] << 8);
+	std::vector<unsigned char> bytes(out_width * out_height * 4);
+	file.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+	if (!file)
+	{
+		return false;
+	}
+
+	out_pixels.resize(out_width * out_height);
+	for (int pixelIndex = 0; pixelIndex < out_width * out_height; ++pixelIndex)
+	{
+		unsigned char const* pixel = &bytes[pixelIndex * 4];
+		out_pixels[pixelIndex] = Rgba8(pixel[2], pixel[1], pixel[0], pixel[3]);
+	}
+	return true;
+}
+
+static int GetChannelError(unsigned char a, unsigned char b)
+{
+	return a > b ? a - b : b - a;
+}
+
+//-----------------------------------------------------------------------------------------------
+// Renders the fixed frame and compares it with the checked-in golden image. On a mismatch the
+// frame is written next to the golden one; after checking it by eye, copy it over the golden
+// image to accept an intended change.
+//
+static int TestSoftwareRasterizerGolden()
+{
+	SoftwareRasterizer rasterizer(GOLDEN_FRAME_WIDTH, GOLDEN_FRAME_HEIGHT);
+	rasterizer.ClearScreen(Rgba8(10, 10, 30, 255));
+
+	float viewWidth = static_cast<float>(GOLDEN_FRAME_WIDTH / 2);
+	ViewportData viewport;
+	viewport.TopLeftX = 0.f;
+	viewport.TopLeftY = 0.f;
+	viewport.Width = viewWidth;
+	viewport.Height = static_cast<float>(GOLDEN_FRAME_HEIGHT);
+	viewport.MinDepth = 0.f;
+	viewport.MaxDepth = 1.f;
+	DrawGoldenView(rasterizer, viewport, Vec2(0.f, 0.f));
+	viewport.TopLeftX = viewWidth;
+	DrawGoldenView(rasterizer, viewport, Vec2(-10.f, 5.f));
+	rasterizer.EndFrame();
+
+	int goldenWidth = 0;
+	int goldenHeight = 0;
+	std::vector<Rgba8> goldenPixels;
+	if (!ReadGoldenTGA(GOLDEN_IMAGE_PATH, goldenWidth, goldenHeight, goldenPixels))
+	{
+		rasterizer.WriteTGA(GOLDEN_ACTUAL_PATH);
+		printf("FAILED SoftwareRasterizerGolden: could not read %s; this frame was written to %s\n", GOLDEN_IMAGE_PATH, GOLDEN_ACTUAL_PATH);
+		return 1;
+	}
+	if (goldenWidth != GOLDEN_FRAME_WIDTH || goldenHeight != GOLDEN_FRAME_HEIGHT)
+	{
+		printf("FAILED SoftwareRasterizerGolden: %s is %dx%d, expected %dx%d\n", GOLDEN_IMAGE_PATH, goldenWidth, goldenHeight, GOLDEN_FRAME_WIDTH, GOLDEN_FRAME_HEIGHT);
+		return 1;
+	}
+
+	int numMismatchedPixels = 0;
+	int firstMismatchIndex = -1;
+	for (int y = 0; y < GOLDEN_FRAME_HEIGHT; ++y)
+	{
+		Rgba8 const* row = rasterizer.GetPixels() + y * rasterizer.GetPitch();
+		for (int x = 0; x < GOLDEN_FRAME_WIDTH; ++x)
+		{
+			Rgba8 const& actual = row[x];
+			Rgba8 const& expected = goldenPixels[y * GOLDEN_FRAME_WIDTH + x];
+			if (GetChannelError(actual.r, expected.r) > GOLDEN_MAX_CHANNEL_ERROR || GetChannelError(actual.g, expected.g) > GOLDEN_MAX_CHANNEL_ERROR ||
+				GetChannelError(actual.b, expected.b) > GOLDEN_MAX_CHANNEL_ERROR || GetChannelError(actual.a, expected.a) > GOLDEN_MAX_CHANNEL_ERROR)
+			{
+				if (firstMismatchIndex < 0)
+				{
+					firstMismatchIndex = y * GOLDEN_FRAME_WIDTH + x;
+				}
+				++numMismatchedPixels;
+			}
+		}
+	}
+
+	if (numMismatchedPixels > 0)
+	{
+		rasterizer.WriteTGA(GOLDEN_ACTUAL_PATH);
+		printf("FAILED SoftwareRasterizerGolden: %d pixels differ from %s, first at (%d, %d); this frame was written to %s\n",
+			   numMismatchedPixels, GOLDEN_IMAGE_PATH, firstMismatchIndex % GOLDEN_FRAME_WIDTH, firstMismatchIndex / GOLDEN_FRAME_WIDTH, GOLDEN_ACTUAL_PATH);
+		return 1;
+	}
+	return 0;
+}
+
+int RunSoftwareRasterizerTests()
+{
+	return TestSoftwareRasterizerGolden();
+}